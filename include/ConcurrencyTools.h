@@ -0,0 +1,193 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ConcurrencyTools_h
+#define Mezz_Test_ConcurrencyTools_h
+
+/// @file
+/// @brief Tools for deciding how much work to run at once and for spreading that work across threads.
+
+#include "DataTypes.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        /// @brief Get how many threads this process can usefully keep busy at once.
+        /// @details This starts with the count of hardware threads, then narrows it by the CPU affinity mask and on
+        /// Linux by any cgroup CPU quota. Containers and CI executors are frequently given a fraction of a large
+        /// machine and std::thread::hardware_concurrency() alone would massively oversubscribe them.
+        /// @return The number of threads that can run at once, this never returns less than 1.
+        Whole MEZZ_LIB GetAvailableConcurrency();
+
+        /// @brief The signature of one task run by @ref RunOnWorkerPool.
+        /// @details The first parameter is the index of the worker running the task, always less than the worker
+        /// count. The second is the index of the task to be run, always less than the task count.
+        using WorkerPoolTask = std::function<void(Whole, SizeType)>;
+
+        /// @brief Run a number of independent tasks using no more than a fixed number of threads.
+        /// @details Each worker thread pulls the next task index from a shared counter until all tasks are claimed,
+        /// so tasks are started in index order and a slow task never holds up the dispatch of the others. If the
+        /// worker count is 1 or less every task is run in index order on the calling thread.
+        /// @param WorkerCount The most threads to run tasks on at once.
+        /// @param TaskCount How many tasks to run, each index from 0 up to this will be passed to Task once.
+        /// @param Task The work to do. This must be safe to call from several threads at once.
+        void MEZZ_LIB RunOnWorkerPool(const Whole WorkerCount, const SizeType TaskCount, const WorkerPoolTask& Task);
+
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        /// @brief A thread of its own that writes text to a stream, so the threads making the text never wait on it.
+        /// @details Text handed to Write is written whole and in the order it was handed over. Anything still waiting
+        /// when this is destroyed is written before the destructor returns.
+        class MEZZ_LIB OutputWriter
+        {
+        private:
+            /// @brief Where all the text goes.
+            std::ostream& Destination;
+            /// @brief Protects PendingOutput and Stopping.
+            std::mutex PendingMutex;
+            /// @brief Wakes the writer thread when there is output or it is time to stop.
+            std::condition_variable PendingChanged;
+            /// @brief Text handed over but not yet written.
+            std::vector<String> PendingOutput;
+            /// @brief Set when the writer should finish what is pending and stop.
+            Boole Stopping = false;
+            /// @brief The thread that does all the writing, it must be started after every other member is ready.
+            std::thread WriterThread;
+
+            /// @brief What the writer thread does until it is stopped.
+            void WriteUntilStopped();
+
+        public:
+            /// @brief Start the writer thread.
+            /// @param Output The stream to write to, it must outlive this and not be written to by anything else.
+            explicit OutputWriter(std::ostream& Output);
+            /// @brief Write everything still pending and stop the writer thread.
+            ~OutputWriter();
+
+            /// @brief Delete copy constructor, there is only one writer thread.
+            OutputWriter(const OutputWriter&) = delete;
+            /// @brief Delete move constructor, the writer thread refers to this.
+            OutputWriter(OutputWriter&&) = delete;
+            /// @brief Delete copy assignment, there is only one writer thread.
+            OutputWriter& operator=(const OutputWriter&) = delete;
+            /// @brief Delete move assignment, the writer thread refers to this.
+            OutputWriter& operator=(OutputWriter&&) = delete;
+
+            /// @brief Hand over some text to be written soon. This is safe to call from any thread.
+            /// @param Output The text to write, it is not split or interleaved with any other text.
+            void Write(String Output);
+        };// OutputWriter
+
+        /// @brief A thread of its own that calls back when work runs longer than it was allowed to.
+        /// @details Work is watched from Start until Stop is passed the ID Start returned. If its time runs out first
+        /// its callback is run on the watchdog thread and it is no longer watched. Nothing here stops the work
+        /// itself, what to do about it is up to the callback.
+        class MEZZ_LIB Watchdog
+        {
+        public:
+            /// @brief Called with how long work had been running when it ran out of time.
+            using ExpiryCallback = std::function<void(std::chrono::nanoseconds)>;
+
+        private:
+            /// @brief When one piece of watched work started, when it has to be done by and what to do if it is not.
+            struct WatchedWork
+            {
+                /// @brief When Start was called for this work.
+                std::chrono::steady_clock::time_point Started;
+                /// @brief When the callback is run if Stop has not been called.
+                std::chrono::steady_clock::time_point Deadline;
+                /// @brief What to do when this work runs out of time.
+                ExpiryCallback OnExpired;
+            };
+
+            /// @brief Protects Watched, NextID and Stopping.
+            std::mutex WatchedMutex;
+            /// @brief Wakes the watchdog thread when work is started or it is time to stop.
+            std::condition_variable WatchedChanged;
+            /// @brief The work that has been started and not stopped, by its ID.
+            std::unordered_map<SizeType, WatchedWork> Watched;
+            /// @brief The ID the next piece of work will get.
+            SizeType NextID = 0;
+            /// @brief Set when the watchdog thread should stop.
+            Boole Stopping = false;
+            /// @brief The thread that waits for deadlines, it must be started after every other member is ready.
+            std::thread WatchdogThread;
+
+            /// @brief What the watchdog thread does until it is stopped.
+            void WatchUntilStopped();
+
+        public:
+            /// @brief Start the watchdog thread.
+            Watchdog();
+            /// @brief Stop the watchdog thread, work still being watched never gets a callback.
+            ~Watchdog();
+
+            /// @brief Delete copy constructor, there is only one watchdog thread.
+            Watchdog(const Watchdog&) = delete;
+            /// @brief Delete move constructor, the watchdog thread refers to this.
+            Watchdog(Watchdog&&) = delete;
+            /// @brief Delete copy assignment, there is only one watchdog thread.
+            Watchdog& operator=(const Watchdog&) = delete;
+            /// @brief Delete move assignment, the watchdog thread refers to this.
+            Watchdog& operator=(Watchdog&&) = delete;
+
+            /// @brief Start watching some work. This is safe to call from any thread.
+            /// @param Budget How long the work may run, zero or less means it is not watched at all.
+            /// @param Expired Called on the watchdog thread if the work is not stopped in time.
+            /// @return The ID to pass to Stop when the work is done.
+            SizeType Start(const std::chrono::nanoseconds Budget, ExpiryCallback Expired);
+            /// @brief Stop watching some work. This is safe to call from any thread.
+            /// @param WorkID What Start returned, IDs of work that already ran out of time are ignored.
+            void Stop(const SizeType WorkID);
+        };// Watchdog
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,95 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_FailFastTrigger_h
+#define Mezz_Test_FailFastTrigger_h
+
+/// @file
+/// @brief What decides when a fail fast run has seen a bad enough result to stop.
+
+#include "DataTypes.h"
+#include "TestEnumerations.h"
+
+#include <atomic>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Trips the first time a result at or above a severity is seen, so the rest of the run can stop.
+        /// @details Test groups check every result they store against this, from whichever thread they run on.
+        /// The runner checks it before starting anything new and launched processes are killed once it trips.
+        /// Once tripped it stays tripped.
+        class MEZZ_LIB FailFastTrigger
+        {
+            private:
+                /// @brief Results at or above this trip the trigger.
+                const TestResult Severity;
+                /// @brief Set once a bad enough result was seen, or when tripped by hand.
+                std::atomic<Boole> Tripped{false};
+
+            public:
+                /// @brief Create a trigger that has not been tripped.
+                /// @param TripSeverity The least severe result that should stop the run.
+                explicit FailFastTrigger(const TestResult TripSeverity = TestResult::Failed) noexcept;
+
+                /// @return The least severe result that trips this.
+                TestResult GetSeverity() const noexcept;
+
+                /// @brief Trip this if a result is bad enough. This is safe to call from any thread.
+                /// @param Result A result that was just recorded.
+                /// @return True if this is tripped, by this result or an earlier one.
+                Boole Check(const TestResult Result) noexcept;
+                /// @brief Trip this no matter what results were seen.
+                void Trip() noexcept;
+                /// @return True once this has been tripped.
+                Boole IsTripped() const noexcept;
+
+                /// @brief The flag that is set when this trips, for things like RunCommandStreaming that only poll it.
+                /// @return A reference to a flag that lives as long as this.
+                const std::atomic<Boole>& GetTrippedFlag() const noexcept;
+        };// FailFastTrigger
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,135 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_JunitWriter_h
+#define Mezz_Test_JunitWriter_h
+
+/// @file
+/// @brief A writer of Junit XML that streams results out through a buffer instead of building the whole document.
+
+#include "DataTypes.h"
+#include "TestData.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Writes Junit XML a piece at a time, escaping text straight into one large buffer.
+        /// @details Text is only handed to the stream when the buffer fills, when Flush is called or when this is
+        /// destroyed, so memory use does not grow with the number of results written. The caller is responsible for
+        /// calling the Begin and End functions in matching pairs.
+        class MEZZ_LIB JunitWriter
+        {
+            private:
+                /// @brief Where the finished XML goes.
+                std::ostream& Output;
+                /// @brief XML that has not been handed to Output yet.
+                Mezzanine::String Buffer;
+                /// @brief How much can be in Buffer before it is handed to Output.
+                SizeType BufferLimit;
+
+                /// @brief Add text that needs no escaping.
+                /// @param Raw The text to add as is.
+                void Append(const Mezzanine::StringView Raw);
+                /// @brief Add text that might contain characters with special meaning in XML.
+                /// @param Text The text to escape and add.
+                void AppendEscaped(const Mezzanine::StringView Text);
+                /// @brief Add a duration as a count of seconds, how Junit expects times.
+                /// @param Time The duration to add.
+                void AppendSeconds(const std::chrono::nanoseconds Time);
+                /// @brief Hand the buffer to the stream if it is full enough.
+                void FlushIfFull();
+
+            public:
+                /// @brief How much XML is held before it is written by default.
+                static const SizeType DefaultBufferSize = 1 << 20;
+
+                /// @brief Constructor.
+                /// @param Destination The stream the XML will be written to.
+                /// @param BufferSize How many bytes of XML to gather before writing them.
+                explicit JunitWriter(std::ostream& Destination, const SizeType BufferSize = DefaultBufferSize);
+                /// @brief Destructor, writes anything still buffered.
+                ~JunitWriter();
+
+                /// @brief Deleted copy constructor.
+                JunitWriter(const JunitWriter&) = delete;
+                /// @brief Deleted move constructor.
+                JunitWriter(JunitWriter&&) = delete;
+                /// @brief Deleted copy assignment.
+                JunitWriter& operator=(const JunitWriter&) = delete;
+                /// @brief Deleted move assignment.
+                JunitWriter& operator=(JunitWriter&&) = delete;
+
+                /// @brief Find the test group a result belongs to from its name.
+                /// @param TestName The full name of a test, like "SubProcess::Group::Case::Test".
+                /// @return The name of the group, like "Group", or TestName if it has no group.
+                static Mezzanine::StringView GroupNameOf(const Mezzanine::StringView TestName);
+
+                /// @brief Start the document.
+                /// @param TestCount How many tests there are in every test suite together.
+                void BeginTestSuites(const Whole TestCount);
+                /// @brief Start the results of one test group.
+                /// @param Name The name of the test group.
+                /// @param TestCount How many test cases will be added before this suite ends.
+                /// @param Time How long the group took to run.
+                void BeginTestSuite(const Mezzanine::StringView Name,
+                                    const Whole TestCount,
+                                    const std::chrono::nanoseconds Time);
+                /// @brief Add one result to the current test suite.
+                /// @param OneResult The result to write.
+                void AddTestCase(const TestData& OneResult);
+                /// @brief Finish the current test suite.
+                void EndTestSuite();
+                /// @brief Finish the document and write everything buffered.
+                void EndTestSuites();
+
+                /// @brief Write everything buffered to the stream.
+                void Flush();
+        };// JunitWriter
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,154 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_LatencyHistogram_h
+#define Mezz_Test_LatencyHistogram_h
+
+/// @file
+/// @brief A histogram of timings that uses the same small amount of memory no matter how many it holds.
+
+#include "DataTypes.h"
+#include "SuppressWarnings.h"
+
+#include <chrono>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded") // Emscripten complains about this and is not performance sensitive.
+
+            ///////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Counts timings in log-linear buckets, so recording is constant time and memory is bounded.
+            /// @details Timings below 2^PrecisionBits nanoseconds each get a bucket of their own. Above that every
+            /// power of two is split into 2^(PrecisionBits-1) equal buckets, so any timing is known to within one
+            /// part in 2^(PrecisionBits-1) of itself. With the default of 8 that is better than 1% and takes about
+            /// 60 KB however many timings are recorded, so hours long benchmarks fit easily.
+            /// @n @n
+            /// Histograms with the same precision can be merged, so several runs, threads or processes can be
+            /// combined into one set of percentiles.
+            class MEZZ_LIB LatencyHistogram
+            {
+                public:
+                    /// @brief A integral type suitable for counting any reasonable execution counts.
+                    using CountType = Mezzanine::UInt64;
+                    /// @brief A time precise enough for very small benchmarks.
+                    using TimeType = std::chrono::nanoseconds;
+
+                    /// @brief The precision used when none is passed.
+                    static constexpr Whole DefaultPrecisionBits{8};
+                    /// @brief The least precision allowed, 2 buckets per power of two.
+                    static constexpr Whole MinimumPrecisionBits{2};
+                    /// @brief The most precision allowed, this takes about 13 MB.
+                    static constexpr Whole MaximumPrecisionBits{16};
+
+                private:
+                    /// @brief How many timings landed in each bucket.
+                    std::vector<CountType> Counts;
+                    /// @brief How many bits of each timing are kept.
+                    Whole PrecisionBits;
+                    /// @brief How many timings were recorded in all.
+                    CountType TotalCount = 0;
+                    /// @brief The sum of every timing in nanoseconds.
+                    CountType Sum = 0;
+                    /// @brief The sum of the square of every timing in nanoseconds, for the standard deviation.
+                    PreciseReal SumOfSquares = 0.0;
+                    /// @brief The exact smallest timing recorded.
+                    CountType Smallest = 0;
+                    /// @brief The exact largest timing recorded.
+                    CountType Largest = 0;
+
+                    /// @brief Find the bucket a timing goes in.
+                    /// @param Nanoseconds A timing.
+                    /// @return An index into Counts.
+                    SizeType BucketOf(const CountType Nanoseconds) const noexcept;
+                    /// @brief Find the largest timing that would go in a bucket.
+                    /// @param Bucket An index into Counts.
+                    /// @return The largest nanosecond count in that bucket.
+                    CountType HighestIn(const SizeType Bucket) const noexcept;
+
+                public:
+                    /// @brief Create an empty histogram.
+                    /// @param Precision How many bits of each timing to keep, errors are at most 1 in 2^(Precision-1).
+                    /// @throw std::invalid_argument If Precision is less than MinimumPrecisionBits or more than
+                    /// MaximumPrecisionBits.
+                    explicit LatencyHistogram(const Whole Precision = DefaultPrecisionBits);
+
+                    /// @brief Count one or more timings of the same length.
+                    /// @param Timing How long something took, negative timings are counted as zero.
+                    /// @param Times How many timings of this length to count.
+                    void Record(const TimeType Timing, const CountType Times = 1) noexcept;
+
+                    /// @brief Add all of the timings in another histogram to this one.
+                    /// @param Other A histogram with the same precision as this.
+                    /// @throw std::invalid_argument If the precisions differ.
+                    void Merge(const LatencyHistogram& Other);
+
+                    /// @brief Get the timing that corresponds to a percentage into the sorted timings.
+                    /// @details This chooses the same timing as MicroBenchmarkResults::GetIndexValueFromPercent would,
+                    /// but rounded up to the largest value its bucket holds, then kept between the exact fastest and
+                    /// slowest. So it is never too fast and too slow by at most the precision.
+                    /// @param Percent Where to reach into the timings. With 1.0 the slowest and 0.0 the fastest.
+                    /// @return A timing, or zero if nothing was recorded.
+                    TimeType GetValueAtPercent(PreciseReal Percent) const noexcept;
+
+                    /// @return How many bits of each timing are kept.
+                    Whole GetPrecisionBits() const noexcept;
+                    /// @return The largest error of any timing as a fraction of it, 1 / 2^(PrecisionBits-1).
+                    PreciseReal GetRelativePrecision() const noexcept;
+                    /// @return How many timings were recorded.
+                    CountType GetCount() const noexcept;
+                    /// @return The exact sum of every timing recorded.
+                    TimeType GetTotal() const noexcept;
+                    /// @return The exact fastest timing recorded, or zero if there were none.
+                    TimeType GetFastest() const noexcept;
+                    /// @return The exact slowest timing recorded, or zero if there were none.
+                    TimeType GetSlowest() const noexcept;
+                    /// @return The sample standard deviation of the timings in nanoseconds, zero with fewer than two.
+                    PreciseReal GetStandardDeviation() const noexcept;
+                    /// @return How many buckets this keeps, which is all of the memory it uses.
+                    SizeType GetBucketCount() const noexcept;
+            };// LatencyHistogram
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -48,17 +48,28 @@
 #include "AutomaticTestGroup.h"
 #include "BenchmarkTestGroup.h"
 #include "BenchmarkThreadTestGroup.h"
+#include "ConcurrencyTools.h"
 #include "ConsoleLogic.h"
+#include "FailFastTrigger.h"
+#include "JunitWriter.h"
 #include "OutputBufferGuard.h"
 #include "ProcessTools.h"
 #include "StringManipulation.h"
 #include "SilentTestGroup.h"
+#include "TestCase.h"
 #include "TestData.h"
+#include "TestGroupMatcher.h"
+#include "TestGroupRegistry.h"
 #include "TestMacros.h"
+#include "TestReporter.h"
+#include "TestResultLog.h"
 #include "TestEnumerations.h"
+#include "TestHistory.h"
 #include "TimingTools.h"
 #include "UnitTestGroup.h"
 
+#include <map>
+#include <mutex>
 #include <stdexcept> // Used to throw for TEST_THROW
 
 namespace Mezzanine
@@ -82,25 +93,93 @@ namespace Mezzanine
                 /// @brief The current process depth as interpreted by Main.
                 Boole InSubProcess = false ;
 
+                /// @brief Send results to the parent process as binary records on the result channel.
+                Boole BinaryResults = false;
+
                 /// @brief Force single threaded to help troubleshoot.
                 Boole ForceSingleThread = false;
 
+                /// @brief The most test groups to run at once, this defaults to the CPUs available to this process.
+                Whole WorkerCount = 0;
+
+                /// @brief Which shard of the selected test groups this runs, from 0 to ShardCount - 1.
+                Whole ShardIndex = 0;
+
+                /// @brief How many shards the selected test groups are split across, 1 runs them all.
+                Whole ShardCount = 1;
+
+                /// @brief A duration history every shard shares, used to split the groups by time instead of by name.
+                Mezzanine::String ShardHistoryFileName;
+
+                /// @brief Stop the run as soon as a result at or above FailFastSeverity is recorded.
+                Boole FailFast = false;
+
+                /// @brief The least severe result that stops a fail fast run.
+                TestResult FailFastSeverity = TestResult::Failed;
+
+                /// @brief When set, this is tripped by bad enough results and everything still to run is cancelled.
+                FailFastTrigger* CancelTrigger = nullptr;
+
+                /// @brief How long a test group may run when it does not set its own timeout, zero for no limit.
+                std::chrono::nanoseconds GroupTimeout = std::chrono::nanoseconds::zero();
+
+                /// @brief Fork test groups that need a process of their own from a warm zygote.
+                Boole UseZygote = false;
+
+                /// @brief When set, sub process test groups are run by this instead of by launching this executable.
+                ProcessZygote* Zygote = nullptr;
+
                 /// @brief Skip writing the log file.
                 Boole SkipFile = false;
 
+                /// @brief Skip reading and writing the durations used to start the longest test groups first.
+                Boole SkipHistory = false;
+
+                /// @brief Skip test groups that passed last time if neither they nor the test executable changed.
+                Boole Incremental = false;
+
+                /// @brief One skipped result for each test group an incremental run did not need to run again.
+                UnitTestGroup::TestDataStorageType CacheHits;
+
+                /// @brief Only count successful results instead of storing them, in every group.
+                Boole FailuresOnly = false;
+
                 /// @brief Skip writing the summary at the end.
                 Boole SkipSummary = false;
 
                 /// @brief Create Junit Xml output files?
                 Boole EmitJunitXml = false;
 
+                /// @brief Stream results to a JSON Lines file as each test group finishes?
+                Boole EmitJsonLines = false;
+
+                /// @brief Stream results to a Test Anything Protocol file as each test group finishes?
+                Boole EmitTap = false;
+
+                /// @brief When set, this is given the results of each test group as soon as it finishes and passes
+                /// them on to every reporter from a thread of its own.
+                TestReporterList* Reporter = nullptr;
+
                 /// @brief Should the Benchmarks be run? Defaults to false.
                 Boole DoBenchmark = false;
 
             };// ParsedCommandLineArgs
         RESTORE_WARNING_STATE
 
+        /// @brief Get the arguments after the name of the executable, with each response file replaced by its contents.
+        /// @details An argument starting with @ref ResponseFileToken names a file of more arguments, separated by
+        /// whitespace. Lines in that file starting with '#' are ignored.
+        /// @param argc Should be the argc passed in from the system.
+        /// @param argv Should be the argv passed in from the system.
+        /// @return Every argument in the order given.
+        /// @throw std::runtime_error if a response file cannot be read or response files are nested too deep.
+        std::vector<Mezzanine::String> MEZZ_LIB ExpandCommandLine(int argc, char** argv);
+
         /// @brief Deal with all the fine detail of dealing with command like arguments.
+        /// @details Besides exact names, test groups can be selected with globs like "phys*" or regular expressions
+        /// like "regex=phys.*", and any of those can be prefixed with @ref SkipTestToken to leave groups out. All the
+        /// patterns are gathered into one matcher per direction and each group is checked once, skips are applied
+        /// last so they win no matter where they appear.
         /// @param argc Should be the argc passed in from the system.
         /// @param argv Should be the argv passed in from the system.
         /// @param TestInstances The complete set of tests.
@@ -108,12 +187,29 @@ namespace Mezzanine
         ParsedCommandLineArgs MEZZ_LIB DealWithdCommandLineArgs(int argc,
                                                                 char** argv,
                                                                 const CoreTestGroup& TestInstances);
+
+        /// @brief Create only the registered test groups the command line needs.
+        /// @details When the command line names test groups to run and asks for nothing that needs every group, like
+        /// "all", "automatic", "interactive" or "help", only the named groups and groups named to skip are created.
+        /// Otherwise every registered group is created. This lets a sub process for one group skip creating the rest.
+        /// @param argc Should be the argc passed in from the system.
+        /// @param argv Should be the argv passed in from the system.
+        /// @param TestInstances Test groups created some other way, these are used as they are and never replaced.
+        /// @param CreatedGroups Keeps the groups created here, it must outlive the CoreTestGroup returned.
+        /// @return Every test group in TestInstances plus every registered test group this created.
+        CoreTestGroup MEZZ_LIB CreateSelectedTestGroups(int argc,
+                                                        char** argv,
+                                                        const CoreTestGroup& TestInstances,
+                                                        std::vector<std::unique_ptr<UnitTestGroup>>& CreatedGroups);
+
         /// @brief Print a report of the tests to a stream.
         /// @param AllResults All of the results to appear in the summary.
         /// @param SummaryStream Place to print the results.
+        /// @param UnstoredSuccesses How many successes were counted but are not in AllResults.
         /// @return The worst test result.
         TestResult MEZZ_LIB RenderTestResultSummary(const UnitTestGroup::TestDataStorageType& AllResults,
-                                                    std::ostream& SummaryStream);
+                                                    std::ostream& SummaryStream,
+                                                    const Whole UnstoredSuccesses = 0);
 
         /// @brief Print a report of the timings to a stream.
         /// @param AllTimings All of the timings to appear in the summary.
@@ -127,30 +223,96 @@ namespace Mezzanine
         void MEZZ_LIB RunSubProcessTest(const ParsedCommandLineArgs& Options,
                                         UnitTestGroup& OneTestGroup);
 
+        /// @brief How many successes each test group counted without storing them, by the name of the group.
+        using UnstoredSuccessCounts = std::map<Mezzanine::String, Whole>;
+
+        /// @brief Add up the successes every group counted without storing them.
+        /// @param PerGroup The counts of each group.
+        /// @return The sum of every count in PerGroup.
+        Whole MEZZ_LIB TotalUnstoredSuccesses(const UnstoredSuccessCounts& PerGroup);
+
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The results, timings and counted successes of every test group that has finished in a run.
+        /// @details Groups are added as they finish, from any thread. If a group running in this process hangs, the
+        /// run is abandoned from another thread, which takes what is here to write it out before exiting.
+        class MEZZ_LIB FinishedTestGroups
+        {
+            private:
+                /// @brief Protects every other member.
+                std::mutex FinishedMutex;
+                /// @brief The results of every finished group, those of each group next to each other.
+                UnitTestGroup::TestDataStorageType Results;
+                /// @brief How long each finished group took.
+                std::vector<NamedDuration> Timings;
+                /// @brief The successes each finished group counted but did not store.
+                UnstoredSuccessCounts UnstoredSuccesses;
+
+            public:
+                /// @brief Constructor.
+                /// @param Earlier Results that are already known before any group runs, like incremental cache hits.
+                explicit FinishedTestGroups(UnitTestGroup::TestDataStorageType Earlier = {});
+
+                /// @brief Take the results of a group that has finished.
+                /// @param Group The group, its results are moved out of it.
+                /// @param Timing How long the group took.
+                void Add(UnitTestGroup& Group, NamedDuration Timing);
+                /// @brief Move everything added so far out, appending it to what is already in the parameters.
+                /// @param AllResults Gets the results.
+                /// @param TestTimings Gets the timings.
+                /// @param AllUnstoredSuccesses Gets the counted successes of each group.
+                void TakeAll(UnitTestGroup::TestDataStorageType& AllResults,
+                             std::vector<NamedDuration>& TestTimings,
+                             UnstoredSuccessCounts& AllUnstoredSuccesses);
+        };// FinishedTestGroups
+        RESTORE_WARNING_STATE
+
         /// @brief Run all the tests that run in other threads.
         /// @param Options The options passed in by the user.
-        /// @param AllResults The place to store test results.
-        /// @param TestTimings The place to store all test timings.
-        void MEZZ_LIB RunParallelThreads(const ParsedCommandLineArgs& Options,
-                                         UnitTestGroup::TestDataStorageType& AllResults,
-                                         std::vector<NamedDuration>& TestTimings);
+        /// @param Finished Gets each group as it finishes.
+        void MEZZ_LIB RunParallelThreads(const ParsedCommandLineArgs& Options, FinishedTestGroups& Finished);
 
         /// @brief Run all the tests that DON'T run in other threads.
         /// @param Options The options passed in by the user.
-        /// @param AllResults The place to store test results.
-        /// @param TestTimings The place to store all test timings.
-        void MEZZ_LIB RunSerializedTests(const ParsedCommandLineArgs& Options,
-                                         UnitTestGroup::TestDataStorageType& AllResults,
-                                         std::vector<NamedDuration>& TestTimings);
-
-        void MEZZ_LIB EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults);
+        /// @param Finished Gets each group as it finishes.
+        void MEZZ_LIB RunSerializedTests(const ParsedCommandLineArgs& Options, FinishedTestGroups& Finished);
+
+        /// @brief Name a file so that each shard of a sharded run writes its own.
+        /// @param FileName The name used when the run is not sharded.
+        /// @param Options The options holding the shard this is.
+        /// @return FileName unchanged if not sharded, otherwise with the shard inserted before the extension.
+        Mezzanine::String MEZZ_LIB ShardFileName(const Mezzanine::String& FileName,
+                                                 const ParsedCommandLineArgs& Options);
+
+        /// @brief Write results in the Junit XML format that many CI tools can read.
+        /// @details The results of each test group become one test suite, they are streamed to the file through a
+        /// JunitWriter so the document is never held in memory all at once.
+        /// @param AllResults The results to write.
+        /// @param FileName The file to write them to.
+        /// @param UnstoredSuccesses How many successes each group counted that are not in AllResults, they are
+        /// included in the count of tests of its suite. A group with only these still gets a suite.
+        /// @param TestTimings The timings of the test groups, used for the time of each test suite.
+        void MEZZ_LIB EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults,
+                                       const Mezzanine::String& FileName,
+                                       const UnstoredSuccessCounts& UnstoredSuccesses = {},
+                                       const std::vector<NamedDuration>& TestTimings = {});
+
+        /// @brief Pass the results of groups skipped by an incremental run to a reporter.
+        /// @details Each cache hit stands for a group of its own, so each is passed in a call of its own just like
+        /// the results of a group that ran.
+        /// @param Reporter The reporter to pass them to.
+        /// @param CacheHits The results from @ref SkipUnchangedTests.
+        void MEZZ_LIB ReportCacheHits(TestReporter& Reporter, const UnitTestGroup::TestDataStorageType& CacheHits);
 
         /// @brief Run all the tests per their normal execution policies.
         /// @param Options The options about what tests to run.
         /// @param TestTimings A collection of timings this will add to.
+        /// @param UnstoredSuccesses Set to how many successes were counted but not stored.
         /// @return A collections of all the results.
         UnitTestGroup::TestDataStorageType MEZZ_LIB RunTests(const ParsedCommandLineArgs& Options,
-                                                             std::vector<NamedDuration>& TestTimings);
+                                                             std::vector<NamedDuration>& TestTimings,
+                                                             Whole& UnstoredSuccesses);
 
         /// @brief This is the entry point for the unit test executable.
         /// @details This will construct an AllUnitTestGroups with the listing of unit tests available from cmake
@@ -165,7 +327,8 @@ namespace Mezzanine
         /// process fails. If the main process cannot create child processes it will return EXIT_FAILURE.
         /// @param argc Is interpreted as the amount of passed arguments.
         /// @param argv Is interpreted as the arguments passed in from the launching shell.
-        /// @param TestInstances A group of tests to be executed.
+        /// @param TestInstances A group of tests to be executed, test groups registered with REGISTER_TEST_GROUP are
+        /// added to these as the command line selects them.
         ExitCode MEZZ_LIB MainImplementation(int argc, char** argv, const CoreTestGroup& TestInstances);
 
         /// @brief When display timings with fixed width columns, this is how wide the name column is.
@@ -185,14 +348,66 @@ namespace Mezzanine
         /// @copydoc RunInThisProcessToken
         static const Mezzanine::String DebugBToken("debugtests");
 
+        /// @brief A string the parent passes to a sub process so it sends results back as binary records.
+        static const Mezzanine::String BinaryResultsToken("binaryresults");
+
+        /// @brief Put in front of the names of results that came from a sub process.
+        static const Mezzanine::String SubProcessPrefix("SubProcess::");
+
+        /// @brief The name of the result recorded for a test group that a fail fast run cut short or never started.
+        static const Mezzanine::String CancelledTestName("Cancelled");
+
+        /// @brief The name of the result recorded for a test group that ran longer than its timeout.
+        static const Mezzanine::String TimeoutTestName("Timeout");
+
+        /// @brief The name of the result recorded for a test group whose sub process sent results that could not be
+        /// read.
+        static const Mezzanine::String CorruptResultsTestName("CorruptResults");
+
+        /// @brief The file Junit XML test results are written to, each shard adds its own suffix.
+        static const Mezzanine::String JunitFileName("Mezz_Test_Results.xml");
+
         /// @brief A string that if passed on the command tells this to emit Junit XML test results.
         static const Mezzanine::String JunitXMLAToken("xml");
         /// @brief Another string that if passed on the command tells this to emit Junit XML test results.
         static const Mezzanine::String JunitXMLBToken("junit");
 
+        /// @brief The file a copy of every result is appended to as each test group finishes, unless skipped.
+        static const Mezzanine::String TestResultsFileName("TestResults.txt");
+
+        /// @brief The file JSON Lines test results are streamed to, each shard adds its own suffix.
+        static const Mezzanine::String JsonLinesFileName("Mezz_Test_Results.jsonl");
+        /// @brief A string that if passed on the command tells this to stream JSON Lines test results.
+        static const Mezzanine::String JsonLinesToken("jsonl");
+
+        /// @brief The file Test Anything Protocol results are streamed to, each shard adds its own suffix.
+        static const Mezzanine::String TapFileName("Mezz_Test_Results.tap");
+        /// @brief A string that if passed on the command tells this to stream Test Anything Protocol results.
+        static const Mezzanine::String TapToken("tap");
+
         /// @brief A string that if passed forces single threaded execution.
         static const Mezzanine::String NoThreads("nothreads");
 
+        /// @brief A string that if passed forks sub process tests from a warm zygote process instead of launching them.
+        static const Mezzanine::String ZygoteToken("zygote");
+
+        /// @brief A string that if passed must be followed by which shard to run, like "shard=0/4".
+        static const Mezzanine::String ShardToken("shard=");
+        /// @brief A string that if passed must be followed by a history file every shard reads, like
+        /// "shardhistory=Mezz_Test_History.txt".
+        static const Mezzanine::String ShardHistoryToken("shardhistory=");
+
+        /// @brief A string that if passed stops the run at the first failure.
+        static const Mezzanine::String FailFastToken("failfast");
+        /// @brief A string that if passed must be followed by the result that stops the run, like "failfast=warning".
+        static const Mezzanine::String FailFastAtToken("failfast=");
+
+        /// @brief A string that if passed must be followed by the seconds each test group may run, like "timeout=300".
+        static const Mezzanine::String TimeoutToken("timeout=");
+
+        /// @brief A string that if passed must be followed by the most test groups to run at once, like "-j 4".
+        static const Mezzanine::String WorkerCountToken("-j");
+
         /// @brief A string that if passed on the command tells this to show the usage.
         static const Mezzanine::String HelpToken("help");
 
@@ -211,12 +426,30 @@ namespace Mezzanine
         /// @brief The token to pass on the command line to not emit a log file.
         static const Mezzanine::String SkipFileToken("skipfile");
 
+        /// @brief The token to pass on the command line to only run test groups that changed or did not pass.
+        static const Mezzanine::String IncrementalToken("incremental");
+
+        /// @brief The token to pass on the command line to neither use nor update the history of test durations.
+        static const Mezzanine::String SkipHistoryToken("skiphistory");
+
+        /// @brief The token to pass on the command line to only count successes instead of storing each one.
+        static const Mezzanine::String FailuresOnlyToken("failuresonly");
+
         /// @brief The token to pass on the command line to not emit a log file.
         static const Mezzanine::String DoBenchmarkToken("dobenchmark");
 
         /// @brief The token to pass as a prefix to a test to skip it.
         static const Mezzanine::String SkipTestToken("skip-");
 
+        /// @brief The token to pass as a prefix to a regular expression that selects tests, like "regex=Phys.*".
+        static const Mezzanine::String RegexToken("regex=");
+
+        /// @brief The token to pass as a prefix to a file of more arguments, like "@Selection.txt".
+        static const Mezzanine::String ResponseFileToken("@");
+
+        /// @brief How deep response files can name other response files, this stops files that name each other.
+        static const Mezzanine::Whole MaxResponseFileDepth = 8;
+
         RESTORE_WARNING_STATE
     }// Testing
 }// Mezzanine
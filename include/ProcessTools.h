@@ -45,6 +45,12 @@
 
 #include "DataTypes.h"
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <mutex>
+
 namespace Mezzanine {
 namespace Testing {
 
@@ -56,6 +62,8 @@ SUPPRESS_CLANG_WARNING("-Wpadded")
     {
         /// @brief The output to cout from the called process.
         String ConsoleOutput;
+        /// @brief Everything the called process wrote to its result channel, if it had one.
+        String ResultChannelOutput;
         /// @brief The code returned when the called process exited.
         Integer ExitCode = EXIT_FAILURE;
     };//CommandResult
@@ -81,6 +89,133 @@ RESTORE_WARNING_STATE
     /// @return Returns the ExitCode and Cout output of the command that was run.
     [[nodiscard]]
     CommandResult MEZZ_LIB RunCommand(const StringView Command);
+
+    /// @brief Receives output from a running process as it arrives.
+    /// @details Chunks are handed over as they are read and are not split on lines or any other boundary, the view
+    /// is only valid during the call.
+    using CommandOutputCallback = std::function<void(StringView)>;
+
+    /// @brief The exit code reported for a process that was killed because it ran longer than it was allowed to.
+    /// @details Exit codes and signal numbers are never this low, so it cannot be mistaken for either.
+    constexpr Integer TimedOutExitCode = std::numeric_limits<Integer>::min();
+    /// @brief The exit code reported for a process that was killed because it was cancelled.
+    /// @details Exit codes and signal numbers are never this low, so it cannot be mistaken for either.
+    constexpr Integer CancelledExitCode = TimedOutExitCode + 1;
+
+    /// @brief Launches a different process on the system and hands over its output as it arrives.
+    /// @details This is like the single parameter RunCommand, but nothing is buffered, so output can be handled
+    /// while the process is still running and memory does not grow with how much it prints.
+    /// @param Command The command to attempt to run and direct its output.
+    /// @param OnConsoleOutput Passed each chunk the process writes to cout.
+    /// @param OnResultChannel If set the process gets a result channel, where supported, and this is passed each
+    /// chunk written to it.
+    /// @param Timeout If more than zero the process is killed once it has run this long.
+    /// @param Cancel If set the process is killed soon after this becomes true, from any thread.
+    /// @return Returns the ExitCode of the command that was run, or @ref TimedOutExitCode or @ref CancelledExitCode
+    /// if it was killed.
+    Integer MEZZ_LIB RunCommandStreaming(const StringView Command,
+                                         const CommandOutputCallback& OnConsoleOutput,
+                                         const CommandOutputCallback& OnResultChannel = CommandOutputCallback(),
+                                         const std::chrono::nanoseconds Timeout = std::chrono::nanoseconds::zero(),
+                                         const std::atomic<Boole>* Cancel = nullptr);
+
+    /// @brief The file descriptor a process launched with a result channel can write to, apart from its console.
+    constexpr int ResultChannelDescriptor = 3;
+
+    /// @brief Can launched processes be given a result channel on this system.
+    /// @return True on Posix systems, false on Windows.
+    Boole MEZZ_LIB ResultChannelIsSupported();
+
+    /// @brief Launches a different process on the system with a result channel beside its console output.
+    /// @details This works like the single parameter RunCommand, except the launched process can also write to
+    /// @ref ResultChannelDescriptor and that is collected separately in ResultChannelOutput. Where result
+    /// channels are not supported this acts just like RunCommand.
+    /// @param Command The command to attempt to run and direct its output.
+    /// @return Returns the ExitCode, Cout output and result channel output of the command that was run.
+    [[nodiscard]]
+    CommandResult MEZZ_LIB RunCommandWithResultChannel(const StringView Command);
+
+    /// @brief Write to the result channel this process was launched with.
+    /// @param Data The bytes to write.
+    /// @return True if it was all written, false if there is no result channel.
+    Boole MEZZ_LIB WriteToResultChannel(const StringView Data);
+
+    /// @brief Find the file this process was started from.
+    /// @details Unlike argv[0] this does not depend on how the process was launched, so it is right even when the
+    /// executable was found through the PATH or started with a relative path from another directory.
+    /// @return The full path of the running executable, or an empty String if the system cannot tell.
+    Mezzanine::String MEZZ_LIB GetExecutablePath();
+
+    /// @brief The work a process forked by a ProcessZygote does.
+    /// @details This is passed the name of the job it was asked to do, anything it writes to cout is collected and
+    /// what it returns is used as the exit code of the process. It always has a result channel.
+    using ForkedProcessEntry = std::function<Integer(StringView)>;
+
+SAVE_WARNING_STATE
+SUPPRESS_CLANG_WARNING("-Wpadded")
+
+    /// @brief A helper process forked once, that forks again for each job it is asked to run.
+    /// @details Launching the executable again for every job pays for loading and static initialization each time.
+    /// Forking from a process that was already fully set up skips all of that while each job still gets its own
+    /// process so a crash only takes out that job. @n@n
+    /// The zygote must be created before any threads are started, so that what it forks is in a sane state. Once
+    /// created RunInChild can be called from any number of threads at once. This is only available on Posix
+    /// systems, check IsSupported before creating one.
+    class MEZZ_LIB ProcessZygote
+    {
+        private:
+            /// @brief This protects the control socket so requests from many threads are not interleaved.
+            std::mutex RequestMutex;
+            /// @brief The end of the control socket requests are sent on.
+            int ControlSocket = -1;
+            /// @brief The ID of the zygote process, so it can be cleaned up.
+            int ZygoteID = -1;
+
+        public:
+            /// @brief Fork the zygote process.
+            /// @throw std::runtime_error if the zygote could not be started or zygotes are not supported.
+            /// @param Entry What each forked process should do when asked to run a job.
+            explicit ProcessZygote(const ForkedProcessEntry& Entry);
+            /// @brief Deleted copy constructor, there is only one zygote process.
+            ProcessZygote(const ProcessZygote&) = delete;
+            /// @brief Deleted move constructor, threads may be using this.
+            ProcessZygote(ProcessZygote&&) = delete;
+            /// @brief Tell the zygote process to exit and wait for it.
+            ~ProcessZygote();
+
+            /// @brief Deleted copy assignment, there is only one zygote process.
+            ProcessZygote& operator=(const ProcessZygote&) = delete;
+            /// @brief Deleted move assignment, threads may be using this.
+            ProcessZygote& operator=(ProcessZygote&&) = delete;
+
+            /// @brief Can zygotes be used on this system.
+            /// @return True on Posix systems, false on Windows.
+            static Boole IsSupported();
+
+            /// @brief Have a fresh fork of the zygote run a job and collect its output.
+            /// @throw std::runtime_error if the zygote could not be asked to run the job.
+            /// @param JobName Passed to the entry function in the forked process.
+            /// @return Returns the ExitCode, Cout output and result channel output of the forked process.
+            [[nodiscard]]
+            CommandResult RunInChild(const StringView JobName);
+
+            /// @brief Have a fresh fork of the zygote run a job and hand over its output as it arrives.
+            /// @throw std::runtime_error if the zygote could not be asked to run the job.
+            /// @param JobName Passed to the entry function in the forked process.
+            /// @param OnConsoleOutput Passed each chunk the forked process writes to cout.
+            /// @param OnResultChannel Passed each chunk the forked process writes to its result channel, if set.
+            /// @param Timeout If more than zero the forked process is killed once it has run this long.
+            /// @param Cancel If set the forked process is killed soon after this becomes true, from any thread.
+            /// @return Returns the ExitCode of the forked process, or @ref TimedOutExitCode or
+            /// @ref CancelledExitCode if it was killed.
+            Integer RunInChildStreaming(const StringView JobName,
+                                        const CommandOutputCallback& OnConsoleOutput,
+                                        const CommandOutputCallback& OnResultChannel = CommandOutputCallback(),
+                                        const std::chrono::nanoseconds Timeout = std::chrono::nanoseconds::zero(),
+                                        const std::atomic<Boole>* Cancel = nullptr);
+    };//ProcessZygote
+
+RESTORE_WARNING_STATE
 }// Testing
 }// Mezzanine
 
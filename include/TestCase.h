@@ -0,0 +1,82 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestCase_h
+#define Mezz_Test_TestCase_h
+
+/// @file
+/// @brief The registry that connects test cases declared with TEST_CASE to their test group.
+
+#include "UnitTestGroup.h"
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        /// @brief Get the list of test cases declared for one kind of test group.
+        /// @details This is a function local static so test cases can be registered during static initialization
+        /// no matter what order the test headers are included in.
+        /// @tparam GroupType The class of the test group the test cases belong to.
+        /// @return The test cases registered so far, in the order they were declared.
+        template<typename GroupType>
+        UnitTestGroup::TestCaseListType& TestCasesOf()
+        {
+            static UnitTestGroup::TestCaseListType TestCases;
+            return TestCases;
+        }
+
+        /// @brief Creating one of these adds a test case to the list of its test group.
+        /// @details The TEST_CASE macro creates exactly one of these for each test case it declares.
+        /// @tparam GroupType The class of the test group the test case belongs to.
+        /// @tparam CaseType The class of the test case, it must be derived from GroupType.
+        template<typename GroupType, typename CaseType>
+        struct TestCaseRegistrar
+        {
+            /// @brief Add a maker of CaseType instances to the list of test cases for GroupType.
+            TestCaseRegistrar()
+            {
+                TestCasesOf<GroupType>().push_back(
+                    []{ return std::unique_ptr<UnitTestGroup>(new CaseType); }
+                );
+            }
+        };
+    }// Testing
+}// Mezzanine
+
+#endif
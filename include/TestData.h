@@ -64,9 +64,11 @@ namespace Mezzanine
             /// @brief The name of a given test.
             Mezzanine::String TestName;
             /// @brief The function the test was called from.
-            Mezzanine::String FunctionName;
+            /// @details This refers to text kept by InternTestText, so results in the same function share it.
+            Mezzanine::StringView FunctionName;
             /// @brief The File The test happened in.
-            Mezzanine::String FileName;
+            /// @details This refers to text kept by InternTestText, so results in the same file share it.
+            Mezzanine::StringView FileName;
             /// @brief What line in the file this test occurred when the test was compiled.
             Mezzanine::Whole LineNumber;
             /// @brief How did the test turn out.
@@ -75,13 +77,14 @@ namespace Mezzanine
             /// @brief Create a TestData.
             /// @param Name the name of the test, defaults to "".
             /// @param Result A TestResult, defaults to Testing::Success.
-            /// @param FuncName The name of the function this test was called from, Defaults to "".
-            /// @param File The name of the file in which the test exists, Defaults to "".
+            /// @param FuncName The name of the function this test was called from, Defaults to "". This is interned
+            /// so it does not need to outlive the TestData.
+            /// @param File The name of the file in which the test exists, Defaults to "". This is interned too.
             /// @param Line The line in the file in which the test exists, Defaults to 0.
-            explicit TestData(const String& Name = "",
+            explicit TestData(String Name = "",
                               TestResult Result = Testing::TestResult::Success,
-                              const String& FuncName = "",
-                              const String& File = "",
+                              const Mezzanine::StringView FuncName = "",
+                              const Mezzanine::StringView File = "",
                               Mezzanine::Whole Line = 0);
 
             /// @brief Default copy constructible.
@@ -117,8 +120,54 @@ namespace Mezzanine
             /// @return True if any members differ, false otherwise.
             Boole operator!=(const TestData& Rhs) const;
         };// TestData
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The same information as a TestData, but refering to text owned by something else.
+        /// @details This is what reading a binary test result record produces, so that nothing needs to be
+        /// allocated until the result is actually kept.
+        struct MEZZ_LIB TestDataView
+        {
+            /// @brief The name of a given test.
+            Mezzanine::StringView TestName;
+            /// @brief The function the test was called from.
+            Mezzanine::StringView FunctionName;
+            /// @brief The File The test happened in.
+            Mezzanine::StringView FileName;
+            /// @brief What line in the file this test occurred when the test was compiled.
+            Mezzanine::Whole LineNumber = 0;
+            /// @brief How did the test turn out.
+            TestResult Results = TestResult::Success;
+
+            /// @brief Copy this into a TestData that does not refer to the text this refers to.
+            /// @param NamePrefix Put at the front of the test name, handy for marking where results came from.
+            /// @return A TestData with the same information.
+            TestData ToTestData(const Mezzanine::StringView NamePrefix = Mezzanine::StringView()) const;
+        };// TestDataView
         RESTORE_WARNING_STATE
 
+        /// @brief Get a copy of some text that lasts as long as the process, shared with every equal text.
+        /// @details Test results refer to their function and file names this way, so recording a result never
+        /// copies them. The few most recent texts on each thread are checked first without locking, which answers
+        /// nearly every lookup since tests record many results from the same function and file in a row.
+        /// @param Text The text to find or keep.
+        /// @return A view of the kept copy, or an empty view if Text was empty. This is safe to call from any thread.
+        Mezzanine::StringView MEZZ_LIB InternTestText(const Mezzanine::StringView Text);
+
+        /// @brief Append a compact binary record of a TestData to a buffer.
+        /// @details Each record is a 4 byte length of the rest of the record, then 1 byte for the TestResult, 4 for
+        /// the line number and each string as a 4 byte length and its bytes. Every number is little endian. This
+        /// is much cheaper to read back than the text from streaming a TestData.
+        /// @param ToWrite The TestData to record.
+        /// @param Buffer The place to put the record, it is added after anything already there.
+        void MEZZ_LIB AppendTestDataRecord(const TestData& ToWrite, Mezzanine::String& Buffer);
+
+        /// @brief Read one binary record made by AppendTestDataRecord from the front of a buffer.
+        /// @throw std::runtime_error If the record is complete but does not make sense.
+        /// @param Buffer Text that might start with a record.
+        /// @param Decoded Filled with views into Buffer if a whole record was there.
+        /// @return How many bytes the record used, or 0 if Buffer does not hold a whole record yet.
+        Mezzanine::SizeType MEZZ_LIB ReadTestDataRecord(const Mezzanine::StringView Buffer, TestDataView& Decoded);
+
         /// @brief Trim the whitespace from a line of text and try to interpret the remains as TestResults and a
         /// test name.
         /// @param Line A line of Test that starts with whitespace, then a TestResult String, then has a whitesapce
@@ -0,0 +1,116 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestGroupMatcher_h
+#define Mezz_Test_TestGroupMatcher_h
+
+/// @file
+/// @brief A matcher for the names of test groups, built from exact names, globs and regular expressions.
+
+#include "DataTypes.h"
+
+#include <regex>
+#include <unordered_set>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Decides if the name of a test group matches any of the patterns given to it.
+        /// @details Exact names are kept in a hash set, globs are matched directly and all the regular expressions are
+        /// compiled into one, so checking a name costs about the same no matter how many names were added.
+        /// Names and globs are expected in lower case, like the keys of a CoreTestGroup, regular expressions ignore
+        /// case.
+        class MEZZ_LIB TestGroupMatcher
+        {
+            private:
+                /// @brief Names that must match exactly.
+                std::unordered_set<Mezzanine::String> Names;
+                /// @brief Patterns where '*' matches any run of characters and '?' matches any one character.
+                std::vector<Mezzanine::String> Globs;
+                /// @brief The source of every regular expression, kept to rebuild Combined when one is added.
+                Mezzanine::String RegexSource;
+                /// @brief Every regular expression added so far as one alternation.
+                std::regex Combined;
+                /// @brief True once any regular expression was added.
+                Boole HasRegex = false;
+
+            public:
+                /// @brief Is this a glob rather than a plain name?
+                /// @param Pattern The text to check.
+                /// @return True if it contains a '*' or a '?'.
+                static Boole IsGlob(const Mezzanine::StringView Pattern);
+
+                /// @brief Does some text match a glob?
+                /// @param Glob A pattern where '*' matches any run of characters and '?' matches any one character.
+                /// @param Text The text to check, it must match the whole glob.
+                /// @return True if the glob matches all of the text.
+                static Boole GlobMatches(const Mezzanine::StringView Glob, const Mezzanine::StringView Text);
+
+                /// @brief Match a group with exactly this name.
+                /// @param Name The lower case name of a test group.
+                void AddName(const Mezzanine::StringView Name);
+                /// @brief Match every group a glob matches.
+                /// @param Glob A lower case pattern where '*' matches any run of characters and '?' matches any one.
+                void AddGlob(const Mezzanine::StringView Glob);
+                /// @brief Match every group a regular expression matches in full, ignoring case.
+                /// @param Regex An ECMAScript regular expression.
+                /// @throw std::regex_error if Regex is not a valid regular expression.
+                void AddRegex(const Mezzanine::StringView Regex);
+                /// @brief Add a name or glob, whichever it looks like.
+                /// @param Pattern A lower case name or glob.
+                void AddNameOrGlob(const Mezzanine::StringView Pattern);
+
+                /// @return True if nothing was added so nothing can match.
+                Boole Empty() const;
+
+                /// @brief Does a test group match anything added?
+                /// @param LowerName The lower case name of a test group.
+                /// @return True if any name, glob or regular expression matches.
+                Boole Matches(const Mezzanine::String& LowerName) const;
+        };// TestGroupMatcher
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
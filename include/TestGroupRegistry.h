@@ -0,0 +1,103 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestGroupRegistry_h
+#define Mezz_Test_TestGroupRegistry_h
+
+/// @file
+/// @brief The registry of test groups declared with REGISTER_TEST_GROUP, which are only created once selected.
+
+#include "UnitTestGroup.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        /// @brief Something that creates a fresh instance of one test group.
+        typedef std::function<std::unique_ptr<UnitTestGroup>()> TestGroupFactory;
+        /// @brief The registered test group makers, keyed by the all lower case name of each test group.
+        typedef std::map<Mezzanine::String, TestGroupFactory> TestGroupFactoryMap;
+
+        /// @brief Get every test group registered so far.
+        /// @details This is a function local static so test groups can be registered during static initialization
+        /// no matter what order the test headers are included in. Nothing is instantiated until a factory is called.
+        /// @return The factories registered so far, keyed by the name used on the command line.
+        const TestGroupFactoryMap& MEZZ_LIB RegisteredTestGroups();
+
+        /// @brief Create a test group and check it is named what it was registered as.
+        /// @details The name is how forked and sub-process children find their group again, so a group that does not
+        /// match would silently run as something else or not at all.
+        /// @param GroupName The name the group was registered with, this is case insensitive.
+        /// @param Factory Something that creates the group.
+        /// @return The group Factory created.
+        /// @throw std::logic_error if the group's Name() is not GroupName.
+        std::unique_ptr<UnitTestGroup> MEZZ_LIB CreateNamedTestGroup(const StringView GroupName,
+                                                                     const TestGroupFactory& Factory);
+
+        /// @brief Add a test group maker to the registry.
+        /// @details Groups are created with CreateNamedTestGroup, so each is checked against GroupName.
+        /// @param GroupName The name of the group, this must match what the group's Name() returns, but is case
+        /// insensitive.
+        /// @param Factory Something that creates the group when it is selected to run.
+        /// @throw std::invalid_argument if a group with that name was already registered.
+        void MEZZ_LIB RegisterTestGroup(const StringView GroupName, TestGroupFactory Factory);
+
+        /// @brief Creating one of these adds a test group to the registry without creating the test group itself.
+        /// @details The REGISTER_TEST_GROUP macro creates exactly one of these for each test group it registers.
+        /// @tparam GroupType The class of the test group to register, it must have a static RegisteredName like the
+        /// test group macros declare.
+        template<typename GroupType>
+        struct TestGroupRegistrar
+        {
+            /// @brief Add a maker of GroupType instances to the registry of test groups.
+            TestGroupRegistrar()
+            {
+                RegisterTestGroup(GroupType::RegisteredName,
+                    []{ return std::unique_ptr<UnitTestGroup>(new GroupType); }
+                );
+            }
+        };
+    }// Testing
+}// Mezzanine
+
+#endif
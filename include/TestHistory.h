@@ -0,0 +1,182 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestHistory_h
+#define Mezz_Test_TestHistory_h
+
+/// @file
+/// @brief Tools for remembering how long test groups took and using that to plan the next run.
+
+#include "DataTypes.h"
+#include "TimingTools.h"
+#include "UnitTestGroup.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        /// @brief How long each test group took the last time it was run, keyed by the name of the group.
+        using TestDurationHistory = std::map<Mezzanine::String, std::chrono::nanoseconds>;
+
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wexit-time-destructors")
+        SUPPRESS_CLANG_WARNING("-Wglobal-constructors")
+
+        /// @brief The file the durations of test groups are kept in between runs.
+        static const Mezzanine::String TestHistoryFileName("Mezz_Test_History.txt");
+
+        /// @brief Appended to the name of a test group to name how long it took when it ran alongside others.
+        static const Mezzanine::String ParallelTimingSuffix("-T ");
+        /// @brief Appended to the name of a test group to name how long it took when it ran alone.
+        static const Mezzanine::String SerialTimingSuffix("-S ");
+
+        /// @brief The file incremental runs keep the key and last result of each test group in.
+        static const Mezzanine::String IncrementalFileName("Mezz_Test_Incremental.txt");
+
+        /// @brief The name of the one skipped result that stands in for a test group an incremental run reused.
+        static const Mezzanine::String CacheHitTestName("CacheHit");
+
+        RESTORE_WARNING_STATE
+
+        /// @brief What an incremental run remembers about one test group.
+        struct MEZZ_LIB IncrementalRecord
+        {
+            /// @brief A hash of everything the group's results depend on, see @ref IncrementalKeyOf.
+            UInt64 Key = 0;
+            /// @brief The worst result the group had when it last ran.
+            TestResult Worst = TestResult::Unknown;
+        };
+
+        /// @brief The last key and result of each test group, keyed by the name of the group.
+        using IncrementalHistory = std::map<Mezzanine::String, IncrementalRecord>;
+
+        /// @brief Read the durations of test groups from a stream.
+        /// @details Each line is a count of nanoseconds, one space and then the name of a test group. Lines that do
+        /// not look like that are ignored, so a missing or mangled file just means less history.
+        /// @param HistoryStream The stream to read, usually an ifstream of @ref TestHistoryFileName.
+        /// @return Every duration that could be read.
+        TestDurationHistory MEZZ_LIB LoadTestHistory(std::istream& HistoryStream);
+
+        /// @brief Write the durations of test groups to a stream in the format @ref LoadTestHistory reads.
+        /// @param History The durations to write.
+        /// @param HistoryStream The stream to write to.
+        void MEZZ_LIB SaveTestHistory(const TestDurationHistory& History, std::ostream& HistoryStream);
+
+        /// @brief Record the latest durations of every test group that appears in a set of timings.
+        /// @details Only timings named with @ref ParallelTimingSuffix or @ref SerialTimingSuffix are test groups,
+        /// the rest are about the runner itself and are ignored. Groups that did not run keep their old durations.
+        /// @param History The history to update.
+        /// @param Timings The timings the runner gathered while running tests.
+        void MEZZ_LIB UpdateTestHistory(TestDurationHistory& History, const std::vector<NamedDuration>& Timings);
+
+        /// @brief Order test groups so the longest start first, which keeps a long group from starting last.
+        /// @details Groups that have never been timed are put first because they could be the longest of all,
+        /// then the rest follow from longest to shortest. Ties and untimed groups keep their current order, and if
+        /// there is no history at all nothing is moved.
+        /// @param Tests The test groups to reorder.
+        /// @param History The durations from previous runs.
+        void MEZZ_LIB SortTestsByHistory(std::vector<UnitTestGroup*>& Tests, const TestDurationHistory& History);
+
+        /// @brief Keep only the test groups that belong to one shard of a run split across several processes.
+        /// @details Groups with a recorded duration are dealt out longest first, each to the shard with the least
+        /// work so far, so every shard should take about as long. Groups without one are placed by a hash of
+        /// their name. Either way the result depends only on the names, the history and the shard count, so
+        /// every shard must see the same history or some groups could run twice or not at all.
+        /// @param Tests The test groups selected to run, only the ones in this shard are left.
+        /// @param ShardIndex Which shard this is, from 0 to ShardCount - 1.
+        /// @param ShardCount How many shards the groups are split across.
+        /// @param History The durations from previous runs, can be empty.
+        void MEZZ_LIB SelectShard(std::vector<UnitTestGroup*>& Tests,
+                                  const Whole ShardIndex,
+                                  const Whole ShardCount,
+                                  const TestDurationHistory& History);
+
+        /// @brief Hash the contents of a file, the same way on every platform and every run.
+        /// @param FileName The file to hash, like the test executable.
+        /// @return The 64 bit FNV-1a hash of the file or 0 if it could not be read.
+        UInt64 MEZZ_LIB HashFileContents(const Mezzanine::String& FileName);
+
+        /// @brief Work out the key that must be unchanged for an incremental run to reuse a group's last result.
+        /// @param Group The test group, its name and @ref UnitTestGroup::IncrementalKey are part of the key.
+        /// @param ExecutableHash The hash of the test executable, from @ref HashFileContents.
+        /// @return A hash of all of those together.
+        UInt64 MEZZ_LIB IncrementalKeyOf(const UnitTestGroup& Group, const UInt64 ExecutableHash);
+
+        /// @brief Read what incremental runs remember from a stream.
+        /// @details Each line is a hexadecimal key, the number of a TestResult and then the name of a test group.
+        /// Lines that do not look like that are ignored, so a missing or mangled file just means more groups run.
+        /// @param HistoryStream The stream to read, usually an ifstream of @ref IncrementalFileName.
+        /// @return Every record that could be read.
+        IncrementalHistory MEZZ_LIB LoadIncrementalHistory(std::istream& HistoryStream);
+
+        /// @brief Write what incremental runs remember in the format @ref LoadIncrementalHistory reads.
+        /// @param History The records to write.
+        /// @param HistoryStream The stream to write to.
+        void MEZZ_LIB SaveIncrementalHistory(const IncrementalHistory& History, std::ostream& HistoryStream);
+
+        /// @brief Take out the test groups whose key is unchanged and that passed the last time they ran.
+        /// @param Tests The test groups selected to run, the ones that can be reused are removed.
+        /// @param History What was recorded by earlier incremental runs.
+        /// @param ExecutableHash The hash of the test executable, if 0 nothing is reused.
+        /// @return One @ref TestResult::Skipped result named @ref CacheHitTestName for each group removed.
+        UnitTestGroup::TestDataStorageType MEZZ_LIB SkipUnchangedTests(std::vector<UnitTestGroup*>& Tests,
+                                                                       const IncrementalHistory& History,
+                                                                       const UInt64 ExecutableHash);
+
+        /// @brief Record the key and worst result of each test group that ran.
+        /// @details Groups with neither a stored result nor a counted success did not really run, like benchmarks
+        /// in a run without "dobenchmark", so their old records are kept. Groups with any cancelled or timed out
+        /// result may not have run every test, so their records are removed and they run again next time.
+        /// @param History The records to update.
+        /// @param Ran The test groups that were run.
+        /// @param AllResults The results of the run.
+        /// @param ExecutableHash The hash of the test executable.
+        void MEZZ_LIB UpdateIncrementalHistory(IncrementalHistory& History,
+                                               const std::vector<UnitTestGroup*>& Ran,
+                                               const UnitTestGroup::TestDataStorageType& AllResults,
+                                               const UInt64 ExecutableHash);
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -77,10 +77,13 @@ namespace Mezzanine
                 class MEZZ_LIB FileName : public Mezzanine::Testing::UnitTestGroup                                     \
                 {                                                                                                      \
                     public:                                                                                            \
+                        static constexpr Mezzanine::StringView RegisteredName = QUOTE(TestName);                       \
                         virtual ~FileName() override = default;                                                        \
                         virtual void operator ()() override;                                                           \
                         virtual Mezzanine::String Name() const override                                                \
                             { return QUOTE(TestName); }                                                                \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::TestCasesOf<FileName>(); }                                    \
                 };                                                                                                     \
                 void FileName ::operator ()()
         #endif
@@ -92,10 +95,13 @@ namespace Mezzanine
                 class MEZZ_LIB FileName : public Mezzanine::Testing::AutomaticTestGroup                                \
                 {                                                                                                      \
                     public:                                                                                            \
+                        static constexpr Mezzanine::StringView RegisteredName = QUOTE(TestName);                       \
                         virtual ~FileName() override = default;                                                        \
                         virtual void operator ()() override;                                                           \
                         virtual Mezzanine::String Name() const override                                                \
                             { return QUOTE(TestName); }                                                                \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::TestCasesOf<FileName>(); }                                    \
                 };                                                                                                     \
                 void FileName ::operator ()()
         #endif
@@ -108,10 +114,13 @@ namespace Mezzanine
                 class MEZZ_LIB FileName : public Mezzanine::Testing::BenchmarkTestGroup                                \
                 {                                                                                                      \
                     public:                                                                                            \
+                        static constexpr Mezzanine::StringView RegisteredName = QUOTE(TestName);                       \
                         virtual ~FileName() override = default;                                                        \
                         virtual void operator ()() override;                                                           \
                         virtual Mezzanine::String Name() const override                                                \
                             { return QUOTE(TestName); }                                                                \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::TestCasesOf<FileName>(); }                                    \
                 };                                                                                                     \
                 void FileName ::operator ()()
         #endif
@@ -124,10 +133,13 @@ namespace Mezzanine
                 class MEZZ_LIB FileName : public Mezzanine::Testing::BenchmarkThreadTestGroup                          \
                 {                                                                                                      \
                     public:                                                                                            \
+                        static constexpr Mezzanine::StringView RegisteredName = QUOTE(TestName);                       \
                         virtual ~FileName() override = default;                                                        \
                         virtual void operator ()() override;                                                           \
                         virtual Mezzanine::String Name() const override                                                \
                             { return QUOTE(TestName); }                                                                \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::TestCasesOf<FileName>(); }                                    \
                 };                                                                                                     \
                 void FileName ::operator ()()
         #endif
@@ -140,14 +152,51 @@ namespace Mezzanine
                 class MEZZ_LIB FileName : public Mezzanine::Testing::SilentTestGroup                                   \
                 {                                                                                                      \
                     public:                                                                                            \
+                        static constexpr Mezzanine::StringView RegisteredName = QUOTE(TestName);                       \
                         virtual ~FileName() override = default;                                                        \
                         virtual void operator ()() override;                                                           \
                         virtual Mezzanine::String Name() const override                                                \
                             { return QUOTE(TestName); }                                                                \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::TestCasesOf<FileName>(); }                                    \
                 };                                                                                                     \
                 void FileName ::operator ()()
         #endif
 
+        /// @def TEST_CASE
+        /// @brief Declares an independent named part of a test group, which can run on a different worker than the
+        /// rest of the group. Use it after the group, like: TEST_CASE(FileName, CaseName) { TEST(...) }
+        /// @details Each case runs in a fresh instance of a class derived from the group, so it keeps the group's
+        /// policies but shares no state with the group or other cases. Results are named
+        /// "TestName::CaseName::Test" and are reported with the rest of the group's results.
+        #ifndef TEST_CASE
+            #define TEST_CASE(FileName, CaseName)                                                                      \
+                class MEZZ_LIB FileName##CaseName##TestCase : public FileName                                          \
+                {                                                                                                      \
+                    public:                                                                                            \
+                        virtual ~FileName##CaseName##TestCase() override = default;                                    \
+                        virtual void operator ()() override;                                                           \
+                        virtual Mezzanine::String Name() const override                                                \
+                            { return FileName::Name() + "::" QUOTE(CaseName); }                                        \
+                        virtual const TestCaseListType& TestCases() const override                                     \
+                            { return Mezzanine::Testing::UnitTestGroup::TestCases(); }                                 \
+                };                                                                                                     \
+                inline const Mezzanine::Testing::TestCaseRegistrar<FileName, FileName##CaseName##TestCase>             \
+                    FileName##CaseName##TestCaseRegistrar;                                                             \
+                void FileName##CaseName##TestCase ::operator ()()
+        #endif
+
+        /// @def REGISTER_TEST_GROUP
+        /// @brief Registers a test group to be run, without creating it. The generated autodetect.h does this for the
+        /// group named after each header in the test directory, like: REGISTER_TEST_GROUP(FileName)
+        /// @details Only a small maker is registered when the executable starts, the group itself is created only if
+        /// the command line selects it. The group is registered under FileName::RegisteredName, which the test group
+        /// macros declare and which must match what the group's Name() returns.
+        #ifndef REGISTER_TEST_GROUP
+            #define REGISTER_TEST_GROUP(FileName)                                                                      \
+                inline const Mezzanine::Testing::TestGroupRegistrar<FileName> FileName##Registrar;
+        #endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Tests to use in UnitTestGroup
 
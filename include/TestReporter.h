@@ -0,0 +1,225 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestReporter_h
+#define Mezz_Test_TestReporter_h
+
+/// @file
+/// @brief Reporters that receive test results as each test group finishes, and a few that stream them out.
+
+#include "DataTypes.h"
+#include "UnitTestGroup.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Something that receives test results while the tests are still running.
+        /// @details The runner calls BeginRun once, then ReportResults once for each test group as it finishes and
+        /// then EndRun once. Calls are never made at the same time from two threads, a TestReporterList handles that.
+        class MEZZ_LIB TestReporter
+        {
+            public:
+                /// @brief The type used to walk the results of one test group.
+                typedef UnitTestGroup::const_iterator ResultIterator;
+
+                /// @brief Virtual destructor.
+                virtual ~TestReporter() = default;
+
+                /// @brief Called before any results are reported.
+                virtual void BeginRun();
+                /// @brief Called with the results of one test group as soon as it finishes.
+                /// @param First The first result of the group.
+                /// @param Last One past the last result of the group.
+                virtual void ReportResults(ResultIterator First, ResultIterator Last) = 0;
+                /// @brief Called once every test group has been reported.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                virtual void EndRun(const Whole UnstoredSuccesses);
+        };// TestReporter
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Writes each result as one JSON object per line, so it can be read while the run continues.
+        class MEZZ_LIB JsonLinesReporter : public TestReporter
+        {
+            private:
+                /// @brief Where the JSON goes.
+                std::ostream& Output;
+
+            public:
+                /// @brief Constructor.
+                /// @param Destination The stream to write JSON Lines to, it is flushed after each test group.
+                explicit JsonLinesReporter(std::ostream& Destination);
+                /// @brief Virtual destructor.
+                virtual ~JsonLinesReporter() override = default;
+
+                /// @brief Write one line for each result.
+                /// @param First The first result of the group.
+                /// @param Last One past the last result of the group.
+                virtual void ReportResults(ResultIterator First, ResultIterator Last) override;
+                /// @brief Write one last line with the count of successes never written.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                virtual void EndRun(const Whole UnstoredSuccesses) override;
+        };// JsonLinesReporter
+
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Writes results in the Test Anything Protocol, version 13, with the plan at the end.
+        /// @details Successes are "ok", skipped tests are "ok" with a SKIP directive and everything else is "not ok"
+        /// followed by a YAML block saying where it happened.
+        class MEZZ_LIB TapReporter : public TestReporter
+        {
+            private:
+                /// @brief Where the TAP goes.
+                std::ostream& Output;
+                /// @brief How many test points have been written.
+                Whole TestCount = 0;
+
+            public:
+                /// @brief Constructor.
+                /// @param Destination The stream to write TAP to, it is flushed after each test group.
+                explicit TapReporter(std::ostream& Destination);
+                /// @brief Virtual destructor.
+                virtual ~TapReporter() override = default;
+
+                /// @brief Write the TAP version line.
+                virtual void BeginRun() override;
+                /// @brief Write one test point for each result.
+                /// @param First The first result of the group.
+                /// @param Last One past the last result of the group.
+                virtual void ReportResults(ResultIterator First, ResultIterator Last) override;
+                /// @brief Write the plan.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                virtual void EndRun(const Whole UnstoredSuccesses) override;
+        };// TapReporter
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Passes everything it is given on to any number of reporters from a thread of its own.
+        /// @details Results are copied and queued, so the workers finishing test groups never wait on a reporter or
+        /// the disk it writes to. Reporters are only ever called from the reporter thread, in the order the calls
+        /// were made here.
+        class MEZZ_LIB TestReporterList : public TestReporter
+        {
+            private:
+                /// @brief Every reporter to pass results on to.
+                std::vector<std::unique_ptr<TestReporter>> Reporters;
+                /// @brief Protects PendingCalls, Busy and Stopping.
+                std::mutex PendingMutex;
+                /// @brief Wakes the reporter thread when there is something to report or it is time to stop.
+                std::condition_variable PendingChanged;
+                /// @brief Wakes anything waiting for every queued call to be passed on.
+                std::condition_variable AllReported;
+                /// @brief Calls made here that the reporter thread has not taken yet.
+                std::vector<std::function<void()>> PendingCalls;
+                /// @brief True while the reporter thread is passing on calls it has taken.
+                Boole Busy = false;
+                /// @brief Set when the reporter thread should finish what is pending and stop.
+                Boole Stopping = false;
+                /// @brief The thread that calls the reporters, it must be started after every other member is ready.
+                std::thread ReporterThread;
+
+                /// @brief What the reporter thread does until it is stopped.
+                void ReportUntilStopped();
+                /// @brief Hand a call over to the reporter thread.
+                /// @param Call Something that calls every reporter.
+                void Queue(std::function<void()> Call);
+                /// @brief Hand the end of the run over to the reporter thread.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                void QueueEndRun(const Whole UnstoredSuccesses);
+
+            public:
+                /// @brief Start the reporter thread.
+                TestReporterList();
+                /// @brief Pass on everything still pending and stop the reporter thread.
+                virtual ~TestReporterList() override;
+
+                /// @brief Delete copy constructor, there is only one reporter thread.
+                TestReporterList(const TestReporterList&) = delete;
+                /// @brief Delete move constructor, the reporter thread refers to this.
+                TestReporterList(TestReporterList&&) = delete;
+                /// @brief Delete copy assignment, there is only one reporter thread.
+                TestReporterList& operator=(const TestReporterList&) = delete;
+                /// @brief Delete move assignment, the reporter thread refers to this.
+                TestReporterList& operator=(TestReporterList&&) = delete;
+
+                /// @brief Add a reporter to pass results on to, every reporter must be added before BeginRun.
+                /// @param NewReporter The reporter, this takes ownership of it.
+                void Add(std::unique_ptr<TestReporter> NewReporter);
+                /// @return True if there are no reporters to pass results on to.
+                Boole Empty() const;
+
+                /// @brief Wait until every call made so far has been passed on to the reporters.
+                void WaitUntilReported();
+                /// @brief Wait a limited time for every call made so far to be passed on to the reporters.
+                /// @param Timeout The longest to wait.
+                /// @return True if everything was passed on, false if time ran out first.
+                Boole WaitUntilReported(const std::chrono::nanoseconds Timeout);
+
+                /// @brief Queue this to pass on to every reporter.
+                virtual void BeginRun() override;
+                /// @brief Copy the results of one group to pass on to every reporter, this is safe to call from any
+                /// thread and does not wait for the reporters.
+                /// @param First The first result of the group.
+                /// @param Last One past the last result of the group.
+                virtual void ReportResults(ResultIterator First, ResultIterator Last) override;
+                /// @brief Pass this on to every reporter, and wait for it and everything before it to be passed on.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                virtual void EndRun(const Whole UnstoredSuccesses) override;
+                /// @brief Like EndRun, but only wait a limited time for the reporters.
+                /// @details This is for ending a run that is being abandoned, where a reporter may never return.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                /// @param Timeout The longest to wait.
+                /// @return True if everything was passed on, false if time ran out first.
+                Boole EndRunWithin(const Whole UnstoredSuccesses, const std::chrono::nanoseconds Timeout);
+        };// TestReporterList
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,148 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestResultLog_h
+#define Mezz_Test_TestResultLog_h
+
+/// @file
+/// @brief The crash safe log of results written to TestResults.txt as each test group finishes.
+
+#include "DataTypes.h"
+#include "TestReporter.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Where the results of one test group are in a TestResultLog file.
+        struct MEZZ_LIB TestResultLogIndexEntry
+        {
+            /// @brief The name of the test group.
+            Mezzanine::String GroupName;
+            /// @brief How many bytes into the file the results of the group start.
+            UInt64 Offset = 0;
+            /// @brief How many bytes the results of the group take.
+            UInt64 Length = 0;
+        };
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Appends the results of each test group to a file as soon as the group finishes.
+        /// @details Each group is handed to the operating system with a single write as it is reported, so a run that
+        /// is killed keeps every result reported before it died. Writes are only synced to the disk every
+        /// @ref SyncEveryGroups groups or @ref SyncInterval, whichever comes first, so logging barely slows the run.
+        /// @n @n
+        /// When the run ends an index is appended saying where each group's results are, followed by a last line
+        /// saying where the index starts, so a reader can find any group without scanning the file. A file from a
+        /// run that died has no index but is otherwise complete.
+        class MEZZ_LIB TestResultLog : public TestReporter
+        {
+            private:
+                /// @brief The index entries for every group written so far.
+                std::vector<TestResultLogIndexEntry> Index;
+                /// @brief Reused to render the results of each group.
+                std::ostringstream Rendered;
+                /// @brief When the file was last synced to the disk.
+                std::chrono::steady_clock::time_point LastSync;
+                /// @brief How many bytes have been written, which is where the next write goes.
+                UInt64 Written = 0;
+                /// @brief How many groups were written since the file was last synced.
+                Whole UnsyncedGroups = 0;
+                /// @brief The operating system's handle on the file, or -1 if it could not be opened.
+                int FileDescriptor = -1;
+
+                /// @brief Append text to the file.
+                /// @param Text The text to write in full.
+                void Append(const Mezzanine::String& Text);
+                /// @brief Make sure everything written is on the disk.
+                void Sync();
+
+            public:
+                /// @brief Sync after at least this many groups.
+                static const Whole SyncEveryGroups = 64;
+                /// @brief Sync when at least this long passed since the last sync.
+                static constexpr std::chrono::milliseconds SyncInterval{ 500 };
+                /// @brief The line before the index entries.
+                static const Mezzanine::StringView IndexHeader;
+                /// @brief The start of the last line, which is followed by the offset of the IndexHeader.
+                static const Mezzanine::StringView IndexLocationPrefix;
+
+                /// @brief Constructor, this replaces any existing file.
+                /// @param FileName The file to write the results to.
+                explicit TestResultLog(const Mezzanine::String& FileName);
+                /// @brief Destructor, syncs and closes the file.
+                virtual ~TestResultLog() override;
+
+                /// @brief Deleted copy constructor.
+                TestResultLog(const TestResultLog&) = delete;
+                /// @brief Deleted move constructor.
+                TestResultLog(TestResultLog&&) = delete;
+                /// @brief Deleted copy assignment.
+                TestResultLog& operator=(const TestResultLog&) = delete;
+                /// @brief Deleted move assignment.
+                TestResultLog& operator=(TestResultLog&&) = delete;
+
+                /// @return True if the file could be opened for writing.
+                Boole IsOpen() const;
+
+                /// @brief Append the results of one test group to the file.
+                /// @param First The first result of the group.
+                /// @param Last One past the last result of the group.
+                virtual void ReportResults(ResultIterator First, ResultIterator Last) override;
+                /// @brief Append the index and sync the file.
+                /// @param UnstoredSuccesses How many successes were counted but never reported individually.
+                virtual void EndRun(const Whole UnstoredSuccesses) override;
+        };// TestResultLog
+        RESTORE_WARNING_STATE
+
+        /// @brief Read the index from the end of a file written by a TestResultLog.
+        /// @param Log A stream of the whole file, it must be seekable.
+        /// @return Where each group's results are, or nothing if the file has no index because the run died.
+        std::vector<TestResultLogIndexEntry> MEZZ_LIB ReadTestResultLogIndex(std::istream& Log);
+    }// Testing
+}// Mezzanine
+
+#endif
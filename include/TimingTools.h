@@ -44,6 +44,7 @@
 /// @brief TestData, TestDataStorage and UnitTestGroup class definitions.
 
 #include "DataTypes.h"
+#include "LatencyHistogram.h"
 #include "SuppressWarnings.h"
 
 #include <chrono>
@@ -99,6 +100,45 @@ namespace Mezzanine
         /// @return The modified stream.
         std::ostream& MEZZ_LIB operator<<(std::ostream& Stream, const NamedDuration& TimingToStream);
 
+        /// @brief What it costs to time nothing at all, so it can be taken back out of real timings.
+        /// @details Every MicroBenchmark sample is the difference of two reads of the clock, so even an empty
+        /// functor appears to take some time. For kernels that take tens of nanoseconds this is most of each sample.
+        struct MEZZ_LIB TimerCalibration
+        {
+            /// @brief The median time measured between two back to back clock reads, removed from every sample.
+            std::chrono::nanoseconds Overhead = std::chrono::nanoseconds{0};
+            /// @brief How much the overhead itself varies, the gap between its 10th and 90th percentiles.
+            /// @details Samples that differ by less than this cannot be told apart.
+            std::chrono::nanoseconds Uncertainty = std::chrono::nanoseconds{0};
+            /// @brief The smallest step the clock was seen to take.
+            std::chrono::nanoseconds Resolution = std::chrono::nanoseconds{0};
+
+            /// @brief Remove the overhead from one sample.
+            /// @param Measured A raw sample, including the cost of reading the clock.
+            /// @return The sample without the overhead, but never less than zero.
+            std::chrono::nanoseconds RemoveOverhead(const std::chrono::nanoseconds Measured) const
+                { return Measured > Overhead ? Measured - Overhead : std::chrono::nanoseconds{0}; }
+        };
+
+        /// @brief Measure the cost of timing nothing on this machine right now.
+        /// @return A freshly measured calibration, this takes around a millisecond.
+        TimerCalibration MEZZ_LIB CalibrateTimer();
+
+        /// @brief The calibration every MicroBenchmark uses.
+        /// @details This is measured the first time it is needed and then kept for the rest of the process.
+        /// @return A reference to a calibration that lives as long as the process.
+        const TimerCalibration& MEZZ_LIB GetTimerCalibration();
+
+        /// @brief How many of its timings a MicroBenchmarkResults keeps once it has worked out its numbers.
+        enum class TimingRetention : Mezzanine::UInt8
+        {
+            None,       ///< Keep no timings, only the numbers, so the results cost no memory per timing.
+            Unsorted,   ///< Keep the timings in UnsortOriginalTimings in the order they were taken, but do not sort.
+                        ///< Each percentile looked up later is selected again, in time proportional to the timings.
+            Sorted      ///< The default, also keep a sorted copy in SortedTimings so any percentile is a lookup.
+                        ///< This costs a sort and a second copy, ask for Unsorted when only the fixed ones matter.
+        };
+
         SAVE_WARNING_STATE
         SUPPRESS_CLANG_WARNING("-Wpadded") // Emscripten complains about this and is not performance sensitive.
 
@@ -127,28 +167,70 @@ namespace Mezzanine
                 using TimingLists = std::vector<TimeType>;
 
                 /// @brief From a collection of nanoseconds fill out this structure.
-                /// @param Timings A list of nanoseconds to measure and get the interesting numbers from.
+                /// @details The fixed percentiles are found by selection rather than sorting, so with
+                /// TimingRetention::Unsorted or None this takes time in proportion to the number of timings. The
+                /// default, TimingRetention::Sorted, still sorts them into SortedTimings.
+                /// @param Timings A list of nanoseconds to measure and get the interesting numbers from. Pass this
+                /// with std::move to avoid a copy.
                 /// @param PrecalculatedTotal Sometimes the total runtime is acquired while running tests. If this is
                 /// non-zero this will be used instead of calculated.
-                MicroBenchmarkResults(const TimingLists& Timings, const TimeType& PrecalculatedTotal );
+                /// @param Keep Which of the timings to keep after the numbers are worked out.
+                MicroBenchmarkResults(TimingLists Timings,
+                                      const TimeType& PrecalculatedTotal,
+                                      const TimingRetention Keep = TimingRetention::Sorted);
+
+                /// @brief From a collection of raw clock differences remove the timer overhead, then fill this out.
+                /// @details When each timing covers a batch of calls the overhead is removed once per batch, then
+                /// the rest is split evenly between the calls in it, rounded to the nearest nanosecond.
+                /// @param Timings A list of nanoseconds each still including the cost of reading the clock.
+                /// @param PrecalculatedTotal The wall time of the whole benchmark, this is not adjusted.
+                /// @param TimerOverhead The calibration to remove from each timing and keep in this.
+                /// @param BatchCalls How many back to back calls each timing covers.
+                /// @param Keep Which of the timings to keep after the numbers are worked out.
+                MicroBenchmarkResults(TimingLists Timings,
+                                      const TimeType& PrecalculatedTotal,
+                                      const TimerCalibration& TimerOverhead,
+                                      const CountType BatchCalls = 1,
+                                      const TimingRetention Keep = TimingRetention::Sorted);
 
                 MicroBenchmarkResults(const MicroBenchmarkResults&) = default;
                 MicroBenchmarkResults(MicroBenchmarkResults&&) = default;
                 ~MicroBenchmarkResults() = default;
 
                 /// @brief Create a copy of this with none of the zero entries.
+                /// @details The copy keeps the same timings as this, less the zeroes. Sorted timings are not sorted
+                /// again, the zeroes are just cut off the front.
                 /// @return Another MircoBenchmarkResults without a slew of pesky zeros from shorter test iterations.
+                /// @throw std::logic_error If this kept no timings, so there are no zeroes to remove.
                 MicroBenchmarkResults CopyWithoutZeroes() const;
 
                 /// @brief Get an Index that corresponds to the percentile of performance.
                 /// @param Percent Where to reach into the timings. With 1.0 the slowest and 0.0 the fastest.
-                /// @return A index for a value from the Original Timings vector.
+                /// @return A index for a value from the sorted timings.
                 TimingLists::size_type GetIndexFromPercent(PreciseReal Percent) const;
                 /// @brief Get a value from the original timings that corresponds to a percentage into to it.
+                /// @details With sorted timings this is a lookup. With only unsorted ones each call copies them and
+                /// selects in the copy, which takes time in proportion to the number of timings but changes nothing
+                /// in this. Keep them sorted to look up many percentiles.
                 /// @param Percent Where to reach into the timings. With 1.0 the slowest and 0.0 the fastest.
-                /// @return A value from the Original Timings vector.
+                /// @return A value from the Original Timings vector, or zero if there were no timings.
+                /// @throw std::logic_error If this kept no timings.
                 TimeType GetIndexValueFromPercent(PreciseReal Percent) const;
 
+                /// @brief Which timings were kept.
+                TimingRetention Retention = TimingRetention::Sorted;
+
+                /// @brief The timer overhead that was removed from every timing, zero if nothing was removed.
+                /// @details Its Uncertainty is how far any one timing might still be off, which matters most when
+                /// comparing timings only a few nanoseconds long.
+                TimerCalibration Calibration;
+
+                /// @brief How many calls each timing covers, 1 unless this came from a BatchedMicroBenchmark.
+                /// @details Timings and percentiles are always per call, but when this is more than 1 each is the
+                /// average of a batch. So percentiles describe how batches varied and hide how single calls varied,
+                /// the slowest single call is likely much slower than Slowest.
+                CountType BatchSize = 1;
+
                 /// @brief How many times was the timed item executed.
                 CountType Iterations = 0;
                 /// @brief How much was the total runtime with as much of the benchmark removed as possible.
@@ -176,13 +258,84 @@ namespace Mezzanine
                 TimeType FasterThan1Percent = TimeType{0};
                 /// @brief The slowest (most time units) execution time.
                 TimeType Slowest = TimeType{0};
-                /// @brief The raw times gathered by a test, sorted by performance.
+                /// @brief The standard error of Average as a fraction of it, how far Average could be off by chance.
+                /// @details This is the sample standard deviation over the square root of the number of timings,
+                /// divided by the Average. It is zero with fewer than two timings or a zero Average.
+                PreciseReal RelativeStandardError = 0.0;
+
+                /// @brief The time of the very first call, which is in no other statistic, if it was measured apart.
+                /// @details Only AutoMicroBenchmark measures this, it is zero otherwise. The first call often pays
+                /// for cache misses, page faults and lazy initialization the rest do not.
+                TimeType ColdTiming = TimeType{0};
+                /// @brief How many calls were made after the first and before timings were kept, to let them settle.
+                CountType WarmupIterations = 0;
+                /// @brief The raw times gathered by a test, sorted by performance, only with TimingRetention::Sorted.
                 TimingLists SortedTimings;
-                /// @brief The unsorted timings to help study caching effects.
+                /// @brief The unsorted timings to help study caching effects, empty with TimingRetention::None.
                 TimingLists UnsortOriginalTimings;
             };
         RESTORE_WARNING_STATE
 
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded") // Emscripten complains about this and is not performance sensitive.
+
+            /// @brief The same numbers as MicroBenchmarkResults, but from a LatencyHistogram instead of every timing.
+            /// @details This takes the same memory for a billion timings as for ten, so it suits benchmarks that run
+            /// for minutes or hours. Percentiles are accurate to the precision of the histogram, while Iterations,
+            /// Total, Average, Fastest and Slowest are exact. Results from several runs can be merged.
+            struct MEZZ_LIB HistogramBenchmarkResults
+            {
+                /// @brief A integral type suitable for counting any reasonable execution counts.
+                using CountType = MicroBenchmarkResults::CountType;
+                /// @brief A time precise enough for very small benchmarks.
+                using TimeType = MicroBenchmarkResults::TimeType;
+
+                /// @brief Fill out this structure from a histogram of timings.
+                /// @param Timings The timings, already without the timer overhead.
+                /// @param PrecalculatedTotal The wall time of the whole benchmark.
+                /// @param TimerOverhead The calibration that was removed from each timing, to keep in this.
+                explicit HistogramBenchmarkResults(LatencyHistogram Timings,
+                                                   const TimeType& PrecalculatedTotal = TimeType{0},
+                                                   const TimerCalibration& TimerOverhead = TimerCalibration{});
+
+                /// @brief Add the timings from another benchmark of the same thing to these and redo every number.
+                /// @param Other Results with a histogram of the same precision. Its wall time is added to this.
+                /// @throw std::invalid_argument If the histograms have different precisions.
+                void Merge(const HistogramBenchmarkResults& Other);
+
+                /// @brief The timer overhead that was removed from every timing, zero if nothing was removed.
+                TimerCalibration Calibration;
+                /// @brief Every timing, counted in buckets.
+                LatencyHistogram Histogram;
+
+                /// @brief How many times was the timed item executed.
+                CountType Iterations = 0;
+                /// @brief How much was the total runtime with as much of the benchmark removed as possible.
+                TimeType Total = TimeType{0};
+                /// @brief What was the actual time this took to execute, as measured by external clock.
+                TimeType WallTotal = TimeType{0};
+
+                /// @brief The mean execution time; the Total time divided by the number of iterations.
+                TimeType Average = TimeType{0};
+                /// @brief The fastest (fewest time units) execution time.
+                TimeType Fastest = TimeType{0};
+                /// @brief The timing that beats out only 1 percent of the others at being the fastest.
+                TimeType FasterThan99Percent = TimeType{0};
+                /// @brief The timing that beats out 10 percent of the others at being the fastest.
+                TimeType FasterThan90Percent = TimeType{0};
+                /// @brief The meduan execution time; the execution time in the middle.
+                TimeType Median = TimeType{0};
+                /// @brief The timing that beats out 90 percent of the others at being the fastest.
+                TimeType FasterThan10Percent = TimeType{0};
+                /// @brief The timing that beats out 99 percent of the others at being the fastest.
+                TimeType FasterThan1Percent = TimeType{0};
+                /// @brief The slowest (most time units) execution time.
+                TimeType Slowest = TimeType{0};
+                /// @brief The standard error of Average as a fraction of it, how far Average could be off by chance.
+                PreciseReal RelativeStandardError = 0.0;
+            };
+        RESTORE_WARNING_STATE
+
         /// @brief Time a single execution of some functor.
         /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
         /// @param  ToTime A functor to time the execution of.
@@ -190,22 +343,29 @@ namespace Mezzanine
         template<typename Functor>
         MicroBenchmarkResults MicroBenchmark(Functor&& ToTime)
         {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
             MicroBenchmarkResults::TimingLists Results;
             Results.reserve(1);
 
             TestTimer Bench;
             ToTime();
             Results.push_back(Bench.GetLength());
-            return MicroBenchmarkResults{ Results, Results[0] };
+            // The one timing is also the wall time, so both lose the overhead.
+            const MicroBenchmarkResults::TimeType WallTotal{ TimerOverhead.RemoveOverhead(Results[0]) };
+            return MicroBenchmarkResults{ std::move(Results), WallTotal, TimerOverhead };
         }
 
         /// @brief Run the passed functor a number of times and track run times of these.
         /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
         /// @param ToTime A functor to time the execution of.
+        /// @param Keep Which of the timings the results should keep.
         /// @return A performance profile as an instance of MicroBenchmarkResults.
         template<typename Functor>
-        MicroBenchmarkResults MicroBenchmark(Mezzanine::UInt32 Iterations, Functor&& ToTime)
+        MicroBenchmarkResults MicroBenchmark(Mezzanine::UInt32 Iterations,
+                                             Functor&& ToTime,
+                                             const TimingRetention Keep = TimingRetention::Sorted)
         {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
             MicroBenchmarkResults::TimingLists Results;
             Results.reserve(Iterations);
 
@@ -222,19 +382,22 @@ namespace Mezzanine
                     {std::chrono::duration_cast<MicroBenchmarkResults::TimeType>(Current-Begin)};
                 Results.push_back(Length);
             }
-            return MicroBenchmarkResults{Results, Current-StartTime};
+            return MicroBenchmarkResults{std::move(Results), Current-StartTime, TimerOverhead, 1, Keep};
         }
 
         /// @brief Run the passed functor repeatedly until the total execution time exceeds the minumum duration.
         /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
         /// @param ToTime A functor to time the execution of.
         /// @param PreallocateCount How many results should we store space for, defaults to 1,000,000.
+        /// @param Keep Which of the timings the results should keep.
         /// @return A performance profile as an instance of MicroBenchmarkResults.
         template<typename Functor>
         MicroBenchmarkResults MicroBenchmark(const std::chrono::nanoseconds& MinimumDuration,
                                              Functor&& ToTime,
-                                             const SizeType PreallocateCount = 1000000)
+                                             const SizeType PreallocateCount = 1000000,
+                                             const TimingRetention Keep = TimingRetention::Sorted)
         {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
             MicroBenchmarkResults::TimingLists Results;
             Results.reserve(PreallocateCount);
 
@@ -252,7 +415,195 @@ namespace Mezzanine
                     {std::chrono::duration_cast<MicroBenchmarkResults::TimeType>(CurrentTime-TrialBegin)};
                 Results.push_back(Length);
             }
-            return MicroBenchmarkResults{Results, CurrentTime - StartTime};
+            return MicroBenchmarkResults{std::move(Results), CurrentTime - StartTime, TimerOverhead, 1, Keep};
+        }
+
+        /// @brief Like the duration MicroBenchmark, but counts timings in a histogram instead of keeping each one.
+        /// @details Nothing is allocated while timing and the memory used does not grow, so this can run for hours.
+        /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
+        /// @param MinimumDuration Keep calling the functor until this much time has passed.
+        /// @param ToTime A functor to time the execution of.
+        /// @param PrecisionBits How precise percentiles should be, see LatencyHistogram.
+        /// @return A performance profile as an instance of HistogramBenchmarkResults.
+        template<typename Functor>
+        HistogramBenchmarkResults HistogramMicroBenchmark(const std::chrono::nanoseconds& MinimumDuration,
+                                                          Functor&& ToTime,
+                                                          const Whole PrecisionBits =
+                                                              LatencyHistogram::DefaultPrecisionBits)
+        {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
+            LatencyHistogram Timings(PrecisionBits);
+
+            std::chrono::high_resolution_clock::time_point StartTime{ std::chrono::high_resolution_clock::now() };
+            std::chrono::high_resolution_clock::time_point TargetTime{ StartTime + MinimumDuration };
+            std::chrono::high_resolution_clock::time_point CurrentTime{ std::chrono::high_resolution_clock::now() };
+
+            while(TargetTime >= CurrentTime)
+            {
+                std::chrono::high_resolution_clock::time_point TrialBegin{ std::chrono::high_resolution_clock::now() };
+                ToTime();
+                CurrentTime = std::chrono::high_resolution_clock::now();
+
+                Timings.Record(TimerOverhead.RemoveOverhead(
+                    std::chrono::duration_cast<MicroBenchmarkResults::TimeType>(CurrentTime-TrialBegin)));
+            }
+            return HistogramBenchmarkResults{std::move(Timings), CurrentTime - StartTime, TimerOverhead};
+        }
+
+        /// @brief How long each batch of a BatchedMicroBenchmark should take unless another duration is passed.
+        /// @details This is long enough that clock overhead and resolution are tiny parts of every batch.
+        const std::chrono::nanoseconds DefaultBatchDuration{std::chrono::microseconds{10}};
+        /// @brief The most calls a BatchedMicroBenchmark will put in one batch, for functors the compiler removed.
+        const MicroBenchmarkResults::CountType MaximumBatchSize{MicroBenchmarkResults::CountType{1} << 30};
+
+        /// @brief Find how many back to back calls of a functor it takes to last a given duration.
+        /// @details This doubles the count until one batch lasts long enough, so it spends at most about twice the
+        /// target duration calling the functor.
+        /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
+        /// @param ToTime A functor to time the execution of.
+        /// @param TargetDuration How long one batch should last.
+        /// @return The number of calls to put in each batch, at least 1 and at most MaximumBatchSize.
+        template<typename Functor>
+        MicroBenchmarkResults::CountType FindBatchSize(Functor& ToTime, const std::chrono::nanoseconds& TargetDuration)
+        {
+            MicroBenchmarkResults::CountType BatchSize{1};
+            while(BatchSize < MaximumBatchSize)
+            {
+                TestTimer Batch;
+                for(MicroBenchmarkResults::CountType Call{0}; Call<BatchSize; Call++)
+                    { ToTime(); }
+                if(TargetDuration <= Batch.GetLength())
+                    { break; }
+                BatchSize *= 2;
+            }
+            return BatchSize;
+        }
+
+        /// @brief Time batches of back to back calls, for functors that take less time than reading the clock.
+        /// @details The number of calls in each batch is chosen so that a batch lasts about TargetDuration. Each
+        /// timing in the results is the time of a batch, less the timer overhead, split between its calls.
+        /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
+        /// @param Samples How many batches to time.
+        /// @param ToTime A functor to time the execution of.
+        /// @param TargetDuration How long each batch should last.
+        /// @param Keep Which of the timings the results should keep.
+        /// @return A performance profile as an instance of MicroBenchmarkResults, with BatchSize set.
+        template<typename Functor>
+        MicroBenchmarkResults BatchedMicroBenchmark(Mezzanine::UInt32 Samples,
+                                                    Functor&& ToTime,
+                                                    const std::chrono::nanoseconds& TargetDuration =
+                                                        DefaultBatchDuration,
+                                                    const TimingRetention Keep = TimingRetention::Sorted)
+        {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
+            const MicroBenchmarkResults::CountType BatchSize{ FindBatchSize(ToTime, TargetDuration) };
+            MicroBenchmarkResults::TimingLists Results;
+            Results.reserve(Samples);
+
+            std::chrono::high_resolution_clock::time_point Current;
+            std::chrono::high_resolution_clock::time_point StartTime{ std::chrono::high_resolution_clock::now() };
+
+            for(Mezzanine::UInt32 Counter{0}; Counter<Samples; Counter++)
+            {
+                std::chrono::high_resolution_clock::time_point Begin{std::chrono::high_resolution_clock::now()};
+                for(MicroBenchmarkResults::CountType Call{0}; Call<BatchSize; Call++)
+                    { ToTime(); }
+                Current = std::chrono::high_resolution_clock::now();
+
+                MicroBenchmarkResults::TimeType Length
+                    {std::chrono::duration_cast<MicroBenchmarkResults::TimeType>(Current-Begin)};
+                Results.push_back(Length);
+            }
+            return MicroBenchmarkResults{std::move(Results), Current-StartTime, TimerOverhead, BatchSize, Keep};
+        }
+
+        /// @brief How many timings the warmup of an AutoMicroBenchmark gathers before comparing them to the last.
+        const Mezzanine::SizeType WarmupWindowSize{16};
+        /// @brief How far apart, as a fraction, the medians of consecutive warmup windows may be and still be stable.
+        const PreciseReal WarmupTolerance{0.05};
+        /// @brief The most windows an AutoMicroBenchmark warms up for before it measures, stable or not.
+        const Mezzanine::SizeType MaximumWarmupWindows{64};
+        /// @brief The fewest timings an AutoMicroBenchmark keeps, even when fewer would meet its error target.
+        const MicroBenchmarkResults::CountType MinimumAutoIterations{30};
+        /// @brief The most timings an AutoMicroBenchmark keeps, even when more would be needed to meet its target.
+        const MicroBenchmarkResults::CountType MaximumAutoIterations{10000000};
+        /// @brief The relative standard error an AutoMicroBenchmark aims for unless another is passed.
+        const PreciseReal DefaultRelativeStandardError{0.01};
+
+        /// @brief Have timings settled down, so the median of a later batch of them is close to an earlier one?
+        /// @param Earlier Some timings.
+        /// @param Later Timings taken right after Earlier.
+        /// @param Tolerance How far apart the medians may be, as a fraction of the larger one.
+        /// @return True if both have timings and their medians are close enough.
+        Boole MEZZ_LIB TimingsAreStable(const MicroBenchmarkResults::TimingLists& Earlier,
+                                        const MicroBenchmarkResults::TimingLists& Later,
+                                        const PreciseReal Tolerance = WarmupTolerance);
+
+        /// @brief Estimate how many timings it will take for the average to have a given relative standard error.
+        /// @param Pilot Some timings of the thing to benchmark, already warmed up.
+        /// @param TargetRelativeError The largest relative standard error wanted, like 0.01 for 1%.
+        /// @param Budget Roughly how long the timings may take, the count is cut down to fit in this.
+        /// @return A count at least MinimumAutoIterations and at most MaximumAutoIterations.
+        MicroBenchmarkResults::CountType MEZZ_LIB AutoIterationCount(const MicroBenchmarkResults::TimingLists& Pilot,
+                                                                     const PreciseReal TargetRelativeError,
+                                                                     const std::chrono::nanoseconds& Budget);
+
+        /// @brief Time the first call alone, warm up until timings settle, then take as many timings as it takes.
+        /// @details The first call is kept apart as the ColdTiming. After that timings are gathered in windows of
+        /// WarmupWindowSize until the median of one window is within WarmupTolerance of the one before, or
+        /// MaximumWarmupWindows have run. The last window is used to estimate how many timings it will take to get
+        /// the relative standard error of the average down to the target, and that many are timed for the results.
+        /// @tparam Functor Any function-like callable type which accepts no parameters and returns none.
+        /// @param ToTime A functor to time the execution of.
+        /// @param TargetRelativeError The largest relative standard error wanted, like 0.01 for 1%.
+        /// @param MaximumDuration Roughly the longest this should take, this wins over the error target.
+        /// @return A performance profile as an instance of MicroBenchmarkResults, with ColdTiming and
+        /// WarmupIterations set.
+        template<typename Functor>
+        MicroBenchmarkResults AutoMicroBenchmark(Functor&& ToTime,
+                                                 const PreciseReal TargetRelativeError = DefaultRelativeStandardError,
+                                                 const std::chrono::nanoseconds& MaximumDuration =
+                                                     std::chrono::seconds{10})
+        {
+            const TimerCalibration& TimerOverhead = GetTimerCalibration();
+            TestTimer Elapsed;
+
+            TestTimer Cold;
+            ToTime();
+            const MicroBenchmarkResults::TimeType ColdTiming{ TimerOverhead.RemoveOverhead(Cold.GetLength()) };
+
+            MicroBenchmarkResults::CountType WarmupIterations{0};
+            MicroBenchmarkResults::TimingLists Pilot;
+            for(Mezzanine::SizeType WindowCount{0}; WindowCount<MaximumWarmupWindows; WindowCount++)
+            {
+                MicroBenchmarkResults::TimingLists Window;
+                Window.reserve(WarmupWindowSize);
+                for(Mezzanine::SizeType Counter{0}; Counter<WarmupWindowSize; Counter++)
+                {
+                    std::chrono::high_resolution_clock::time_point Begin{std::chrono::high_resolution_clock::now()};
+                    ToTime();
+                    std::chrono::high_resolution_clock::time_point Current{std::chrono::high_resolution_clock::now()};
+                    Window.push_back(TimerOverhead.RemoveOverhead(
+                        std::chrono::duration_cast<MicroBenchmarkResults::TimeType>(Current-Begin)));
+                }
+                WarmupIterations += WarmupWindowSize;
+
+                const Boole Stable{ TimingsAreStable(Pilot, Window) };
+                Pilot = std::move(Window);
+                if(Stable)
+                    { break; }
+            }
+
+            const std::chrono::nanoseconds Spent{ Elapsed.GetLength() };
+            const MicroBenchmarkResults::CountType Iterations{
+                AutoIterationCount(Pilot,
+                                   TargetRelativeError,
+                                   MaximumDuration > Spent ? MaximumDuration - Spent : std::chrono::nanoseconds{0}) };
+
+            MicroBenchmarkResults Results{ MicroBenchmark(static_cast<Mezzanine::UInt32>(Iterations), ToTime) };
+            Results.ColdTiming = ColdTiming;
+            Results.WarmupIterations = WarmupIterations;
+            return Results;
         }
     }// Testing
 }// Mezzanine
@@ -44,12 +44,14 @@
 /// @brief UnitTestGroup class definitions.
 
 
+#include "FailFastTrigger.h"
 #include "TestData.h"
 #include "TestEnumerations.h"
 
 #include <vector>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <type_traits>
 
 namespace Mezzanine
@@ -75,11 +77,45 @@ namespace Mezzanine
         public:
             /// @brief The type use to store the results of tests, largely used to clarify derived types.
             typedef std::vector<TestData> TestDataStorageType;
+            /// @brief Makers of fresh instances of every test case declared for a group with TEST_CASE.
+            typedef std::vector<std::function<std::unique_ptr<UnitTestGroup>()>> TestCaseListType;
 
         private:
             /// @brief The test macros will all store their data here.
             TestDataStorageType TestDataStorage;
 
+            /// @brief One slot in TestNameIndex, the hash of a test name and where that test is in TestDataStorage.
+            typedef std::pair<std::size_t, SizeType> TestNameSlot;
+
+            /// @brief An open addressing hash table of every test in TestDataStorage, to find repeated names without
+            /// searching it or copying names. Empty slots have an index of NoTest, it is never more than half full.
+            std::vector<TestNameSlot> TestNameIndex;
+
+            /// @brief Name() followed by "::", made the first time a test is added.
+            String TestNamePrefix;
+
+            /// @brief How many successful results were counted instead of stored.
+            Whole UnstoredSuccessCount = 0;
+
+            /// @brief Set by OverrideSuccessDetails to replace KeepSuccessDetails().
+            Boole SuccessDetailsOverridden = false;
+
+            /// @brief What OverrideSuccessDetails set, only used if SuccessDetailsOverridden is set.
+            Boole SuccessDetailsOverride = true;
+
+            /// @brief Every stored result is checked against this if it is set, see WatchForFailFast.
+            FailFastTrigger* RunFailFast = nullptr;
+
+            /// @brief Store a test result after making sure no other result has its name.
+            /// @param CurrentTest The New test results.
+            /// @param EmitResult Should the result be printed to the TestLog if EmitIntermediaryTestResults allows.
+            void StoreTestResult(TestData&& CurrentTest, const Boole EmitResult);
+
+            /// @brief Put a test in TestNameIndex, growing it first if needed.
+            /// @param NameHash The hash of the test's name.
+            /// @param Index Where the test is in TestDataStorage.
+            void IndexTestName(const std::size_t NameHash, const SizeType Index);
+
         protected:
             /// @brief A place for each test to send its logs.
             /// @details This should be strictly preferred to cout because this is thread safe.
@@ -107,6 +143,32 @@ namespace Mezzanine
             /// @return Any string that uniquely identifies a test.
             virtual Mezzanine::String Name() const = 0;
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////////////
+            // Test cases, independent parts of a group that can run on different workers.
+
+            /// @brief Get every test case declared for this group with TEST_CASE.
+            /// @details Each test case is a fresh instance of a class derived from this group, so it shares no
+            /// state with the group or the other cases and can run at the same time as them. The test group macros
+            /// override this, test groups written without them have no test cases.
+            /// @return A list of functions that each make one test case, this default is empty.
+            virtual const TestCaseListType& TestCases() const;
+
+            /// @brief Run the tests in this group and then each of its test cases, one at a time.
+            /// @details This is how groups are run anywhere they cannot be spread across workers. Test cases not yet
+            /// started when CancellationRequested becomes true are not run at all.
+            void RunWithTestCases();
+
+            /// @brief Create one test case of this group, set to run the way this group was set to.
+            /// @details Each test case is a fresh instance, so anything set on this instance for the run, like
+            /// OverrideSuccessDetails and WatchForFailFast, is passed on to it here.
+            /// @param CaseIndex Which entry of TestCases() to create.
+            /// @return The test case, ready to run.
+            std::unique_ptr<UnitTestGroup> CreateTestCase(const SizeType CaseIndex) const;
+
+            /// @brief Take the results and log of a test case that has finished running.
+            /// @param FinishedCase A test case of this group that has been run. Its results are already named with
+            /// this group's name.
+            void AddTestCaseResults(const UnitTestGroup& FinishedCase);
 
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Policy class methods, Test policy classes will implement these. 90% of tests classes ignore these.
@@ -136,6 +198,26 @@ namespace Mezzanine
             /// override this and return false.
             virtual Boole ShouldRunAutomatically() const;
 
+            /// @brief Extra text that decides if an incremental run can reuse the last result of this group.
+            /// @details Incremental runs skip a group that passed last time if the test executable and this key are
+            /// both unchanged. Groups that read files or other outside inputs should return something that changes
+            /// when those do, like a hash or modification time of the inputs.
+            /// @return Defaults to an empty String, so only changes to the test executable rerun the group.
+            virtual Mezzanine::String IncrementalKey() const;
+
+            /// @brief How long this group may run before it is given up on and recorded as TestResult::Unknown.
+            /// @details Groups run in a process of their own are killed when this runs out. A group run in this process
+            /// cannot be stopped, so the run ends right there after writing out the groups that finished.
+            /// @return Defaults to zero, which uses the timeout given on the command line if there is one.
+            virtual std::chrono::nanoseconds Timeout() const;
+
+            /// @brief Should successful results be stored in full, or only counted?
+            /// @details Groups that record a huge number of checks can return false so memory use and reporting
+            /// time depend only on how many checks did not succeed. Counted successes are not checked for repeated
+            /// names and are not printed as they happen.
+            /// @return Defaults to true.
+            virtual Boole KeepSuccessDetails() const;
+
             //////////////////////////////////////////////////////
             // MetaPolicy methods, don't override these, they use the policy methods.
 
@@ -149,6 +231,31 @@ namespace Mezzanine
             /// (IsMultiThreadSafe() || IsMultiThreadSafe()).
             Boole CanBeParallel() const;
 
+            /// @brief Will successful results be stored in full?
+            /// @return What OverrideSuccessDetails set if it was called, otherwise KeepSuccessDetails().
+            Boole StoresSuccessDetails() const;
+
+            /// @brief Replace what KeepSuccessDetails() says for this instance, like the command line does.
+            /// @details Test cases made by CreateTestCase are given the same override.
+            /// @param Keep True to store every successful result in full, false to only count them.
+            void OverrideSuccessDetails(const Boole Keep);
+
+            /// @brief How many successful results were only counted.
+            /// @return A count of successes that are not among the results of this group.
+            Whole GetUnstoredSuccessCount() const;
+
+            /// @brief Check every result this group stores against a fail fast run, so a bad enough one stops it.
+            /// @param Trigger The trigger of the run or null to stop checking, test cases made by CreateTestCase are
+            /// given the same one.
+            void WatchForFailFast(FailFastTrigger* Trigger) noexcept;
+
+            /// @brief Has the run this group is part of been cancelled?
+            /// @details Groups that run for a long time can check this now and then and return early, and no more of
+            /// a group's test cases are started once it is true. A group that was still running when the run was
+            /// cancelled is recorded as TestResult::Cancelled either way.
+            /// @return True once the fail fast run this group is watched by has been tripped.
+            Boole CancellationRequested() const noexcept;
+
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Make all UnitTestGroups look like a container of TestDatas
 
@@ -179,6 +286,14 @@ namespace Mezzanine
             /// @param CurrentTest The New test results.
             void AddTestResult(TestData&& CurrentTest);
 
+            /// @brief What AddTestResult puts in front of test names.
+            /// @return Name() followed by "::", this is only made once per group because Name() makes a new String.
+            const String& GetTestNamePrefix();
+
+            /// @brief Remove every result from this group without copying them.
+            /// @return All the results this group had, in the order they were recorded.
+            TestDataStorageType TakeTestResults();
+
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Other useful stuff.
 
@@ -209,12 +324,12 @@ namespace Mezzanine
             /// @param Line To make tracking down failures easier the line number of the test
             /// can  be passed in, if not set an empty string is used.
             /// @return A TestResult containing the actual test result.
-            virtual TestResult Test(const String& TestName,
+            virtual TestResult Test(const StringView TestName,
                                     bool TestCondition,
                                     TestResult IfFalse = Testing::TestResult::Failed,
                                     TestResult IfTrue = Testing::TestResult::Success,
-                                    const String& FuncName = "",
-                                    const String& File = "",
+                                    const StringView FuncName = "",
+                                    const StringView File = "",
                                     Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -226,13 +341,13 @@ namespace Mezzanine
             /// @tparam ActualResultsType A type that supports comparison with the ExpectedResultsType on the right
             /// of the == operator and output to ostreams.
             template <typename ExpectedResultsType, typename ActualResultsType>
-            void TestEqual(const String& TestName,
+            void TestEqual(const StringView TestName,
                            ExpectedResultsType ExpectedResults,
                            ActualResultsType ActualResults,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0)
             {
                 TestResult Result = Test( TestName, (ExpectedResults == ActualResults),
@@ -264,14 +379,14 @@ namespace Mezzanine
             /// @tparam ActualResultsType A type that supports comparison with the ExpectedResultsType on the right
             /// and left <= operator with ExpectedResultsType. ActualResultsType output to ostreams.
             template <typename ExpectedResultsType, typename ActualResultsType>
-            void TestEqualEpsilon(const String& TestName,
+            void TestEqualEpsilon(const StringView TestName,
                                   ExpectedResultsType ExpectedResults,
                                   ActualResultsType ActualResults,
                                   Mezzanine::UInt32 EpsilonCount,
                                   TestResult IfFalse = Testing::TestResult::Failed,
                                   TestResult IfTrue = Testing::TestResult::Success,
-                                  const String& FuncName = "",
-                                  const String& File = "",
+                                  const StringView FuncName = "",
+                                  const StringView File = "",
                                   Mezzanine::Whole Line = 0)
             {
                 auto Epsilon( std::numeric_limits<ExpectedResultsType>::epsilon() );
@@ -297,15 +412,15 @@ namespace Mezzanine
             /// @tparam ActualResultsType A type that supports comparison with the ExpectedResultsType on the right
             /// of the == operator and output to ostreams.
             template <typename ExpectedResultsType, typename ActualResultsType>
-            void TestWithinRange(const String& TestName,
+            void TestWithinRange(const StringView TestName,
                                  ExpectedResultsType ExpectedLowerBound,
                                  ExpectedResultsType ExpectedUpperBound,
                                  ActualResultsType ActualResults,
 
                                  TestResult IfFalse = Testing::TestResult::Failed,
                                  TestResult IfTrue = Testing::TestResult::Success,
-                                 const String& FuncName = "",
-                                 const String& File = "",
+                                 const StringView FuncName = "",
+                                 const StringView File = "",
                                  Mezzanine::Whole Line = 0)
             {
                 TestResult Result = Test( TestName,
@@ -325,12 +440,12 @@ namespace Mezzanine
             /// @param TestCallable A lambda or functor to call that ought to throw an exception.
             /// @tparam ExceptionType The type of the exception to catch for a passing test.
             template<typename ExceptionType>
-            void TestThrow(const String& TestName,
+            void TestThrow(const StringView TestName,
                            std::function<void()> TestCallable,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0)
             {
                 Boole Passed{false};
@@ -354,12 +469,12 @@ namespace Mezzanine
             /// @copydoc Test
             /// @brief Test that a given piece of code does not throw.
             /// @param TestCallable A lambda or functor to call that should not throw an exception.
-            void TestNoThrow(const String& TestName,
+            void TestNoThrow(const StringView TestName,
                              std::function<void()> TestCallable,
                              TestResult IfFalse = Testing::TestResult::Failed,
                              TestResult IfTrue = Testing::TestResult::Success,
-                             const String& FuncName = "",
-                             const String& File = "",
+                             const StringView FuncName = "",
+                             const StringView File = "",
                              Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -367,14 +482,14 @@ namespace Mezzanine
             /// @param Expected The amount of microseconds this should take.
             /// @param MaxVariance How many microseconds high or low is this allowed to be.
             /// @param TestCallable A lambda or functor to call that should have predictable performance.
-            void TestTimed(const String& TestName,
+            void TestTimed(const StringView TestName,
                            std::chrono::microseconds Expected,
                            std::chrono::microseconds MaxVariance,
                            std::function<void()> TestCallable,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -386,13 +501,13 @@ namespace Mezzanine
             /// Though less common this might make sense if trying to execute under some hard deadline.
             /// @param TestCallable A lambda or functor to call that should have predictable performance.
             /// @param MaxAcceptable The amount of microseconds this should take less than.
-            void TestTimedUnder(const String& TestName,
+            void TestTimedUnder(const StringView TestName,
                                 std::chrono::microseconds MaxAcceptable,
                                 std::function<void()> TestCallable,
                                 TestResult IfFalse = Testing::TestResult::Failed,
                                 TestResult IfTrue = Testing::TestResult::Success,
-                                const String& FuncName = "",
-                                const String& File = "",
+                                const StringView FuncName = "",
+                                const StringView File = "",
                                 Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -403,13 +518,13 @@ namespace Mezzanine
             /// @tparam ActualHaystackType A type that implements a find method and returns ExpectedNeedleType::npos
             /// when the ExpectedNeedleType instance passed is not found.
             template <typename ExpectedNeedleType, typename ActualHaystackType>
-            void TestStringContains(const String& TestName,
+            void TestStringContains(const StringView TestName,
                                     ExpectedNeedleType ExpectedNeedle,
                                     ActualHaystackType ActualHaystack,
                                     TestResult IfFalse = Testing::TestResult::Failed,
                                     TestResult IfTrue = Testing::TestResult::Success,
-                                    const String& FuncName = "",
-                                    const String& File = "",
+                                    const StringView FuncName = "",
+                                    const StringView File = "",
                                     Mezzanine::Whole Line = 0)
             {
                 TestResult Result = Test( TestName,
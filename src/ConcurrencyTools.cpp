@@ -0,0 +1,297 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The implementation of the tools for spreading work across threads.
+
+#include "ConcurrencyTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+namespace
+{
+    using namespace Mezzanine;
+
+#ifdef __linux__
+    /// @brief Read the first line from a small system file.
+    /// @param FileName The absolute path of the file to read.
+    /// @return The first line of the file or an empty String if it could not be read.
+    String ReadFirstLine(const char* FileName)
+    {
+        std::ifstream SystemFile(FileName);
+        String Line;
+        std::getline(SystemFile, Line);
+        return Line;
+    }
+
+    /// @brief Convert a cgroup CPU quota and period into a count of whole CPUs.
+    /// @param Quota How many microseconds per period this cgroup may run, zero or less means no quota.
+    /// @param Period The length of the accounting period in microseconds.
+    /// @return The quota in CPUs rounded up, so a quota of 1.5 CPUs can keep 2 threads busy, or 0 for no quota.
+    Whole QuotaToCpuCount(const Int64 Quota, const Int64 Period)
+    {
+        if(0 >= Quota || 0 >= Period)
+            { return 0; }
+        return static_cast<Whole>( (Quota + Period - 1) / Period );
+    }
+
+    /// @brief Find the CPU quota of the cgroup this process is in, if there is one.
+    /// @return A count of CPUs or 0 if there is no quota or it could not be read.
+    Whole GetCgroupCpuLimit()
+    {
+        // cgroup v2 keeps the quota and period on one line, like "150000 100000" or "max 100000".
+        const String V2Limit{ ReadFirstLine("/sys/fs/cgroup/cpu.max") };
+        if(!V2Limit.empty())
+        {
+            if(0 == V2Limit.compare(0, 3, "max"))
+                { return 0; }
+            char* QuotaEnd = nullptr;
+            const Int64 Quota{ std::strtoll(V2Limit.c_str(), &QuotaEnd, 10) };
+            return QuotaToCpuCount(Quota, std::strtoll(QuotaEnd, nullptr, 10));
+        }
+
+        // cgroup v1 splits them into two files and uses -1 for no quota.
+        const String V1Quota{ ReadFirstLine("/sys/fs/cgroup/cpu/cpu.cfs_quota_us") };
+        const String V1Period{ ReadFirstLine("/sys/fs/cgroup/cpu/cpu.cfs_period_us") };
+        if(V1Quota.empty() || V1Period.empty())
+            { return 0; }
+        return QuotaToCpuCount(std::strtoll(V1Quota.c_str(), nullptr, 10), std::strtoll(V1Period.c_str(), nullptr, 10));
+    }
+#endif // __linux__
+
+    /// @brief Lower a count of usable CPUs if a new limit is smaller.
+    /// @param Current The current count, 0 means unknown.
+    /// @param Limit Another limit that might apply, 0 means no limit.
+    /// @return Whichever is smaller ignoring zeroes.
+    Whole NarrowCount(const Whole Current, const Whole Limit)
+    {
+        if(0 == Limit)
+            { return Current; }
+        if(0 == Current)
+            { return Limit; }
+        return std::min(Current, Limit);
+    }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        Whole GetAvailableConcurrency()
+        {
+            Whole Available{ std::thread::hardware_concurrency() };
+
+#ifdef __linux__
+            cpu_set_t Affinity;
+            CPU_ZERO(&Affinity);
+            if(0 == ::sched_getaffinity(0, sizeof(Affinity), &Affinity))
+                { Available = NarrowCount(Available, static_cast<Whole>(CPU_COUNT(&Affinity))); }
+            Available = NarrowCount(Available, GetCgroupCpuLimit());
+#endif // __linux__
+
+            return std::max(Available, Whole{1});
+        }
+
+        void RunOnWorkerPool(const Whole WorkerCount, const SizeType TaskCount, const WorkerPoolTask& Task)
+        {
+            if(WorkerCount <= 1)
+            {
+                for(SizeType TaskIndex = 0; TaskIndex < TaskCount; TaskIndex++)
+                    { Task(0, TaskIndex); }
+                return;
+            }
+
+            std::atomic<SizeType> NextTask{0};
+            std::mutex FailureMutex;
+            std::exception_ptr FirstFailure;
+
+            // Each worker claims tasks one at a time until there are none left. An exception would terminate the
+            // whole process if it left a thread, so the first one is kept and rethrown once everything has stopped.
+            auto Worker = [&](const Whole WorkerIndex)
+            {
+                for(SizeType TaskIndex = NextTask++; TaskIndex < TaskCount; TaskIndex = NextTask++)
+                {
+                    try
+                        { Task(WorkerIndex, TaskIndex); }
+                    catch(...)
+                    {
+                        std::lock_guard<std::mutex> Lock(FailureMutex);
+                        if(!FirstFailure)
+                            { FirstFailure = std::current_exception(); }
+                    }
+                }
+            };
+
+            const Whole ThreadCount{ static_cast<Whole>(std::min<SizeType>(WorkerCount, TaskCount)) };
+            std::vector<std::thread> Workers;
+            Workers.reserve(ThreadCount);
+            for(Whole WorkerIndex = 0; WorkerIndex < ThreadCount; WorkerIndex++)
+                { Workers.emplace_back(Worker, WorkerIndex); }
+            for(std::thread& OneWorker : Workers)
+                { OneWorker.join(); }
+
+            if(FirstFailure)
+                { std::rethrow_exception(FirstFailure); }
+        }
+
+        OutputWriter::OutputWriter(std::ostream& Output)
+            : Destination(Output),
+              WriterThread(&OutputWriter::WriteUntilStopped, this)
+            {}
+
+        OutputWriter::~OutputWriter()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(PendingMutex);
+                Stopping = true;
+            }
+            PendingChanged.notify_one();
+            WriterThread.join();
+        }
+
+        void OutputWriter::Write(String Output)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(PendingMutex);
+                PendingOutput.push_back(std::move(Output));
+            }
+            PendingChanged.notify_one();
+        }
+
+        void OutputWriter::WriteUntilStopped()
+        {
+            // Everything pending is taken at once so the lock is never held while writing.
+            std::vector<String> ToWrite;
+            std::unique_lock<std::mutex> Lock(PendingMutex);
+            while(true)
+            {
+                PendingChanged.wait(Lock, [this]{ return Stopping || !PendingOutput.empty(); });
+                if(PendingOutput.empty())
+                    { break; }
+                ToWrite.swap(PendingOutput);
+                Lock.unlock();
+
+                for(const String& OneOutput : ToWrite)
+                    { Destination << OneOutput; }
+                Destination.flush();
+                ToWrite.clear();
+
+                Lock.lock();
+            }
+        }
+
+        Watchdog::Watchdog()
+            : WatchdogThread(&Watchdog::WatchUntilStopped, this)
+            {}
+
+        Watchdog::~Watchdog()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(WatchedMutex);
+                Stopping = true;
+            }
+            WatchedChanged.notify_one();
+            WatchdogThread.join();
+        }
+
+        SizeType Watchdog::Start(const std::chrono::nanoseconds Budget, ExpiryCallback Expired)
+        {
+            const std::chrono::steady_clock::time_point Now{ std::chrono::steady_clock::now() };
+            SizeType WorkID{0};
+            {
+                std::lock_guard<std::mutex> Lock(WatchedMutex);
+                WorkID = NextID++;
+                if(Budget <= std::chrono::nanoseconds::zero())
+                    { return WorkID; }
+                Watched[WorkID] = { Now,
+                                    Now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(Budget),
+                                    std::move(Expired) };
+            }
+            WatchedChanged.notify_one();
+            return WorkID;
+        }
+
+        void Watchdog::Stop(const SizeType WorkID)
+        {
+            std::lock_guard<std::mutex> Lock(WatchedMutex);
+            Watched.erase(WorkID); // Nothing waits on a deadline being removed, so the thread need not be woken.
+        }
+
+        void Watchdog::WatchUntilStopped()
+        {
+            std::unique_lock<std::mutex> Lock(WatchedMutex);
+            while(!Stopping)
+            {
+                if(Watched.empty())
+                {
+                    WatchedChanged.wait(Lock);
+                    continue;
+                }
+
+                // Only a handful of things run at once, so finding the next deadline by looking at each is fine.
+                const auto Next = std::min_element(Watched.cbegin(), Watched.cend(),
+                    [](const auto& Left, const auto& Right){ return Left.second.Deadline < Right.second.Deadline; });
+                const std::chrono::steady_clock::time_point Now{ std::chrono::steady_clock::now() };
+                if(Now < Next->second.Deadline)
+                {
+                    WatchedChanged.wait_until(Lock, Next->second.Deadline);
+                    continue;
+                }
+
+                const std::chrono::nanoseconds Elapsed{ Now - Next->second.Started };
+                const ExpiryCallback OnExpired{ std::move(Next->second.OnExpired) };
+                Watched.erase(Next);
+                Lock.unlock();
+                OnExpired(Elapsed);
+                Lock.lock();
+            }
+        }
+    }// Testing
+}// Mezzanine
@@ -79,17 +79,36 @@ namespace Mezzanine
                                          const Mezzanine::Testing::CoreTestGroup& TestGroups)
         {
             return Mezzanine::String("\nUsage: ") + ThisName + (
-                    " [help] [summary] [testlist] [interactive|automatic] [all]\n\t[skipfile] <Test Names>...\n\n"
+                    " [help] [summary] [testlist] [interactive|automatic] [all]\n"
+                    "\t[skipfile] [@<File>] <Test Names or Patterns>...\n\n"
                     "<Test Name>      Add this test to the list of tests to run.\n"
-                    "Skip-<Test Name> Remove this from the list of tests to run.\n\n"
+                    "Skip-<Test Name> Remove this from the list of tests to run.\n"
+                    "<Glob>           Add tests with matching names, '*' matches anything and '?' one character.\n"
+                    "Regex=<Regex>    Add tests with names matching this regular expression.\n"
+                    "Skip-<Pattern>   Remove tests matching a glob or Regex=<Regex>, even if added after this.\n"
+                    "@<File>          Read more arguments from this file, '#' starts a comment.\n\n"
                     "All:             All test groups will be run.\n"
                     "Interactive:     Only interactive tests will be performed on specified test groups.\n"
                     "Automatic:       Only automated tests will be performed on specified test groups.\n"
                     "Summary:         Display a count of failures and successes.\n"
                     "SkipFile:        Do not store a copy of the results in TestResults.txt.\n"
+                    "SkipHistory:     Do not order tests by, or record, how long they took in Mezz_Test_History.txt.\n"
+                    "Incremental:     Skip groups that passed last time if they and this executable are unchanged.\n"
+                    "FailuresOnly:    Count successful tests instead of keeping each one, to save memory.\n"
                     "DebugTests:      Run tests in the current process in single thread. Skips crash protection,\n"
                     "                 but eases test debugging.\n"
-                    "NoThreads:       Half of Debugtests, forces single threaded, but allows subprocesses"
+                    "NoThreads:       Half of Debugtests, forces single threaded, but allows subprocesses\n"
+                    "Junit:           Write results as Junit XML to Mezz_Test_Results.xml when the tests finish.\n"
+                    "JsonL:           Stream results as JSON Lines to Mezz_Test_Results.jsonl as groups finish.\n"
+                    "TAP:             Stream results as TAP to Mezz_Test_Results.tap as groups finish.\n"
+                    "Zygote:          Fork tests that need their own process from a warm copy of this, not a new one.\n"
+                    "Shard=<I>/<N>:   Split the tests into N shards and only run shard I, from 0 to N-1.\n"
+                    "ShardHistory=<File>:\n"
+                    "                 Split shards by the durations in File, every shard must be given the same.\n"
+                    "FailFast:        Stop at the first failure, cancel running groups and start no more.\n"
+                    "FailFast=<Res>:  Like FailFast, but stop at the first result at least as bad as Res.\n"
+                    "Timeout=<Secs>:  Give up on a test group that runs longer than this, unless it sets its own.\n"
+                    "-j <Count>:      Run at most this many test groups at once, defaults to the available CPUs.\n"
                     "Help:            Display this message.\n\n"
                     "If only test group names are entered, then all tests in those groups are run.\n"
                     "This command is not case sensitive.\n\n"
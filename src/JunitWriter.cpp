@@ -0,0 +1,182 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the streaming Junit XML writer.
+
+#include "JunitWriter.h"
+#include "MezzTest.h"
+#include "TestEnumerations.h"
+
+#include <cstdio>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        JunitWriter::JunitWriter(std::ostream& Destination, const SizeType BufferSize)
+            : Output(Destination),
+              BufferLimit(BufferSize)
+            { Buffer.reserve(BufferSize + BufferSize / 4); }
+
+        JunitWriter::~JunitWriter()
+            { Flush(); }
+
+        void JunitWriter::Append(const StringView Raw)
+            { Buffer.append(Raw.data(), Raw.size()); }
+
+        void JunitWriter::AppendEscaped(const StringView Text)
+        {
+            for(const char OneLetter : Text)
+            {
+                switch(OneLetter)
+                {
+                    case '&':   Buffer.append("&amp;"); break;
+                    case '<':   Buffer.append("&lt;"); break;
+                    case '>':   Buffer.append("&gt;"); break;
+                    case '"':   Buffer.append("&quot;"); break;
+                    case '\'':  Buffer.append("&apos;"); break;
+                    default:    Buffer.push_back(OneLetter); break;
+                }
+            }
+        }
+
+        void JunitWriter::AppendSeconds(const std::chrono::nanoseconds Time)
+        {
+            char Seconds[32];
+            const int Length{ std::snprintf(Seconds, sizeof(Seconds), "%.6f",
+                                            std::chrono::duration<double>(Time).count()) };
+            if(0 < Length)
+                { Buffer.append(Seconds, static_cast<SizeType>(Length)); }
+        }
+
+        void JunitWriter::FlushIfFull()
+        {
+            if(Buffer.size() >= BufferLimit)
+                { Flush(); }
+        }
+
+        void JunitWriter::Flush()
+        {
+            Output.write(Buffer.data(), static_cast<std::streamsize>(Buffer.size()));
+            Buffer.clear();
+        }
+
+        StringView JunitWriter::GroupNameOf(StringView TestName)
+        {
+            if(0 == TestName.compare(0, SubProcessPrefix.size(), SubProcessPrefix))
+                { TestName.remove_prefix(SubProcessPrefix.size()); }
+            return TestName.substr(0, TestName.find("::"));
+        }
+
+        void JunitWriter::BeginTestSuites(const Whole TestCount)
+        {
+            Append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites tests=\"");
+            Append(std::to_string(TestCount));
+            Append("\">\n");
+        }
+
+        void JunitWriter::BeginTestSuite(const StringView Name,
+                                         const Whole TestCount,
+                                         const std::chrono::nanoseconds Time)
+        {
+            Append("    <testsuite name=\"");
+            AppendEscaped(Name);
+            Append("\" tests=\"");
+            Append(std::to_string(TestCount));
+            Append("\" time=\"");
+            AppendSeconds(Time);
+            Append("\">\n");
+        }
+
+        void JunitWriter::AddTestCase(const TestData& OneResult)
+        {
+            Append("        <testcase classname=\"");
+            AppendEscaped(OneResult.FileName);
+            Append("\" name=\"");
+            AppendEscaped(OneResult.TestName);
+
+            switch(OneResult.Results)
+            {
+                case TestResult::Success:
+                    Append("\" />\n");
+                    break;
+
+                case TestResult::Skipped:
+                    Append("\">\n            <skipped />\n        </testcase>\n");
+                    break;
+
+                case TestResult::Cancelled:
+                case TestResult::Failed:
+                case TestResult::Inconclusive:
+                case TestResult::NotApplicable:
+                case TestResult::Unknown:
+                case TestResult::Warning:
+                case TestResult::NonPerformant:
+                    Append("\">\n            <failure type=\"");
+                    AppendEscaped(TestResultToString(OneResult.Results));
+                    Append("\">\n                ");
+                    AppendEscaped(TestResultToFixedBoxString(OneResult.Results));
+                    Append("  ");
+                    AppendEscaped(OneResult.TestName);
+                    Append(" in function '");
+                    AppendEscaped(OneResult.FunctionName);
+                    Append("' at ");
+                    AppendEscaped(OneResult.FileName);
+                    Append(":");
+                    Append(std::to_string(OneResult.LineNumber));
+                    Append(".\n            </failure>\n        </testcase>\n");
+            }
+            FlushIfFull();
+        }
+
+        void JunitWriter::EndTestSuite()
+        {
+            Append("    </testsuite>\n");
+            FlushIfFull();
+        }
+
+        void JunitWriter::EndTestSuites()
+        {
+            Append("</testsuites>\n");
+            Flush();
+        }
+    }// Testing
+}// Mezzanine
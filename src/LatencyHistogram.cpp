@@ -0,0 +1,210 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the constant memory histogram of timings.
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    /// @internal
+    /// @brief How many bits are needed to write a number, 0 for 0.
+    /// @param Value Any number.
+    /// @return The position of the highest set bit plus one.
+    Mezzanine::Whole BitLength(Mezzanine::UInt64 Value) noexcept
+    {
+        Mezzanine::Whole Length{0};
+        for(const Mezzanine::Whole Step : { 32u, 16u, 8u, 4u, 2u, 1u })
+        {
+            if(Value >> Step)
+            {
+                Value >>= Step;
+                Length += Step;
+            }
+        }
+        return Length + static_cast<Mezzanine::Whole>(Value);
+    }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        constexpr Whole LatencyHistogram::DefaultPrecisionBits;
+        constexpr Whole LatencyHistogram::MinimumPrecisionBits;
+        constexpr Whole LatencyHistogram::MaximumPrecisionBits;
+
+        SizeType LatencyHistogram::BucketOf(const CountType Nanoseconds) const noexcept
+        {
+            const CountType LinearCount{ CountType{1} << PrecisionBits };
+            if(Nanoseconds < LinearCount)
+                { return static_cast<SizeType>(Nanoseconds); }
+
+            // Each power of two above the linear part gets half as many buckets as the linear part.
+            const CountType HalfCount{ LinearCount / 2 };
+            const Whole Shift{ BitLength(Nanoseconds) - PrecisionBits };
+            return static_cast<SizeType>(LinearCount + (Shift - 1) * HalfCount + ((Nanoseconds >> Shift) - HalfCount));
+        }
+
+        LatencyHistogram::CountType LatencyHistogram::HighestIn(const SizeType Bucket) const noexcept
+        {
+            const CountType LinearCount{ CountType{1} << PrecisionBits };
+            if(Bucket < LinearCount)
+                { return Bucket; }
+
+            const CountType HalfCount{ LinearCount / 2 };
+            const CountType AboveLinear{ Bucket - LinearCount };
+            const Whole Shift{ static_cast<Whole>(AboveLinear / HalfCount + 1) };
+            const CountType Lowest{ (AboveLinear % HalfCount + HalfCount) << Shift };
+            return Lowest + ((CountType{1} << Shift) - 1);
+        }
+
+        LatencyHistogram::LatencyHistogram(const Whole Precision)
+            : PrecisionBits(Precision)
+        {
+            if(Precision < MinimumPrecisionBits || MaximumPrecisionBits < Precision)
+            {
+                throw std::invalid_argument("LatencyHistogram precision must be from " +
+                                            std::to_string(MinimumPrecisionBits) + " to " +
+                                            std::to_string(MaximumPrecisionBits) + " bits, not " +
+                                            std::to_string(Precision));
+            }
+            const SizeType LinearCount{ SizeType{1} << PrecisionBits };
+            Counts.resize(LinearCount + (64 - PrecisionBits) * (LinearCount / 2), 0);
+        }
+
+        void LatencyHistogram::Record(const TimeType Timing, const CountType Times) noexcept
+        {
+            if(0 == Times)
+                { return; }
+            const CountType Nanoseconds{ Timing.count() < 0 ? 0 : static_cast<CountType>(Timing.count()) };
+
+            Counts[BucketOf(Nanoseconds)] += Times;
+            Smallest = 0 == TotalCount ? Nanoseconds : std::min(Smallest, Nanoseconds);
+            Largest = std::max(Largest, Nanoseconds);
+            TotalCount += Times;
+            Sum += Nanoseconds * Times;
+            const PreciseReal Real{ static_cast<PreciseReal>(Nanoseconds) };
+            SumOfSquares += Real * Real * static_cast<PreciseReal>(Times);
+        }
+
+        void LatencyHistogram::Merge(const LatencyHistogram& Other)
+        {
+            if(Other.PrecisionBits != PrecisionBits)
+            {
+                throw std::invalid_argument("Cannot merge a LatencyHistogram with " +
+                                            std::to_string(Other.PrecisionBits) + " bits of precision into one with " +
+                                            std::to_string(PrecisionBits));
+            }
+            if(0 == Other.TotalCount)
+                { return; }
+
+            std::transform(Counts.cbegin(), Counts.cend(), Other.Counts.cbegin(), Counts.begin(),
+                           [](const CountType Mine, const CountType Theirs) { return Mine + Theirs; });
+            Smallest = 0 == TotalCount ? Other.Smallest : std::min(Smallest, Other.Smallest);
+            Largest = std::max(Largest, Other.Largest);
+            TotalCount += Other.TotalCount;
+            Sum += Other.Sum;
+            SumOfSquares += Other.SumOfSquares;
+        }
+
+        LatencyHistogram::TimeType LatencyHistogram::GetValueAtPercent(PreciseReal Percent) const noexcept
+        {
+            if(0 == TotalCount)
+                { return TimeType{0}; }
+            if(0.0 > Percent)
+                { Percent = 0.0; }
+            if(1.0 < Percent)
+                { Percent = 1.0; }
+
+            // The same timing MicroBenchmarkResults would pick from its sorted timings, counted from one.
+            const CountType Index{ static_cast<CountType>(static_cast<PreciseReal>(TotalCount) * Percent) };
+            const CountType Rank{ std::min(TotalCount, Index + 1) };
+            CountType Seen{0};
+            for(SizeType Bucket{0}; Bucket < Counts.size(); Bucket++)
+            {
+                Seen += Counts[Bucket];
+                if(Rank <= Seen)
+                {
+                    const CountType Value{ std::max(Smallest, std::min(Largest, HighestIn(Bucket))) };
+                    return TimeType{ static_cast<TimeType::rep>(Value) };
+                }
+            }
+            return GetSlowest();
+        }
+
+        Whole LatencyHistogram::GetPrecisionBits() const noexcept
+            { return PrecisionBits; }
+
+        PreciseReal LatencyHistogram::GetRelativePrecision() const noexcept
+            { return 1.0 / static_cast<PreciseReal>(CountType{1} << (PrecisionBits - 1)); }
+
+        LatencyHistogram::CountType LatencyHistogram::GetCount() const noexcept
+            { return TotalCount; }
+
+        LatencyHistogram::TimeType LatencyHistogram::GetTotal() const noexcept
+            { return TimeType{ static_cast<TimeType::rep>(Sum) }; }
+
+        LatencyHistogram::TimeType LatencyHistogram::GetFastest() const noexcept
+            { return TimeType{ static_cast<TimeType::rep>(Smallest) }; }
+
+        LatencyHistogram::TimeType LatencyHistogram::GetSlowest() const noexcept
+            { return TimeType{ static_cast<TimeType::rep>(Largest) }; }
+
+        PreciseReal LatencyHistogram::GetStandardDeviation() const noexcept
+        {
+            if(TotalCount < 2)
+                { return 0.0; }
+            const PreciseReal Count{ static_cast<PreciseReal>(TotalCount) };
+            const PreciseReal Mean{ static_cast<PreciseReal>(Sum) / Count };
+            // Rounding can push this a hair under zero when every timing is the same.
+            const PreciseReal Variance{ (SumOfSquares - Count * Mean * Mean) / (Count - 1.0) };
+            return 0.0 < Variance ? std::sqrt(Variance) : 0.0;
+        }
+
+        SizeType LatencyHistogram::GetBucketCount() const noexcept
+            { return Counts.size(); }
+    }// Testing
+}// Mezzanine
@@ -43,12 +43,23 @@
 
 #include "DataTypes.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <deque>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
-#include <thread>
-#include <mutex>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <regex>
 #include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace
 {
@@ -57,23 +68,335 @@ namespace
     /// @brief Create a type for delegating work to something dynamic based on a string based lookup.
     typedef std::map<Mezzanine::String, std::function<void()>> CallingTableType;
 
-    Mezzanine::String SanitizeTestNameForJunit(const Mezzanine::String& ToSanitize)
+    /// @brief Add one argument to a list, or if it names a response file every argument in that file.
+    /// @param OneArg The argument as it was passed.
+    /// @param Expanded The list of arguments to add to.
+    /// @param Depth How many response files deep this argument came from.
+    void AppendArgument(const Mezzanine::String& OneArg,
+                        std::vector<Mezzanine::String>& Expanded,
+                        const Mezzanine::Whole Depth)
     {
-        Mezzanine::String Sanitized;
-        Sanitized.reserve(ToSanitize.size());
-        for( Mezzanine::String::value_type CurrChar : ToSanitize )
+        if(OneArg.size() <= ResponseFileToken.size() ||
+           0 != OneArg.compare(0, ResponseFileToken.size(), ResponseFileToken))
         {
-            switch (CurrChar)
+            Expanded.push_back(OneArg);
+            return;
+        }
+
+        const Mezzanine::String FileName{ OneArg.substr(ResponseFileToken.size()) };
+        if(MaxResponseFileDepth <= Depth)
+            { throw std::runtime_error("Response file '" + FileName + "' is nested too deeply."); }
+        std::ifstream ResponseFile(FileName);
+        if(!ResponseFile)
+            { throw std::runtime_error("Could not read response file '" + FileName + "'."); }
+
+        Mezzanine::String Line;
+        while(std::getline(ResponseFile, Line))
+        {
+            std::istringstream LineStream(Line);
+            Mezzanine::String Word;
+            while(LineStream >> Word && '#' != Word[0])
+                { AppendArgument(Word, Expanded, Depth + 1); }
+        }
+    }
+
+    /// @brief Interpret the count that follows the worker count token.
+    /// @param Count Text that should be made of only digits.
+    /// @return The count as a number or 0 if it was not a positive number.
+    Mezzanine::Whole StringToWorkerCount(const Mezzanine::String& Count)
+    {
+        if(Count.empty() || Mezzanine::String::npos != Count.find_first_not_of("0123456789"))
+            { return 0; }
+        return static_cast<Mezzanine::Whole>(std::strtoul(Count.c_str(), nullptr, 10));
+    }
+
+    /// @brief Hand complete pieces of streamed output to a parser, keeping only the incomplete end between chunks.
+    /// @param Pending The incomplete end of earlier chunks, this is updated to hold the new incomplete end.
+    /// @param Chunk The newest output.
+    /// @param Parse Called repeatedly with the unparsed output, it returns how many bytes it used from the front or
+    /// 0 if it needs more before it can use any.
+    template<typename ParserType>
+    void ParseStreamChunk(Mezzanine::String& Pending, const Mezzanine::StringView Chunk, const ParserType& Parse)
+    {
+        // When nothing is pending the chunk can be parsed where it is, without copying.
+        Mezzanine::StringView Available{ Chunk };
+        if(!Pending.empty())
+        {
+            Pending.append(Chunk.data(), Chunk.size());
+            Available = Pending;
+        }
+
+        Mezzanine::SizeType Used{0};
+        while(const Mezzanine::SizeType OneUse = Parse(Available.substr(Used)))
+            { Used += OneUse; }
+
+        if(Pending.empty())
+            { Pending.assign(Available.data() + Used, Available.size() - Used); }
+        else
+            { Pending.erase(0, Used); }
+    }
+
+    /// @brief Send every result of a test group to the parent process as binary records.
+    /// @param OneTestGroup A test group that has already been run.
+    void WriteTestResultRecords(const UnitTestGroup& OneTestGroup)
+    {
+        Mezzanine::String Records;
+        for(const TestData& OneResult : OneTestGroup)
+            { AppendTestDataRecord(OneResult, Records); }
+        WriteToResultChannel(Records);
+    }
+
+    /// @brief What a process forked by the test zygote does, the same as what a launched sub process would do.
+    /// @param TestInstances Every test group, as they were before any tests ran.
+    /// @param GroupName The name of the test group to run.
+    /// @return EXIT_SUCCESS if nothing worse than a warning happened.
+    Mezzanine::Integer RunForkedTestGroup(const CoreTestGroup& TestInstances, const Mezzanine::StringView GroupName)
+    {
+        const CoreTestGroup::const_iterator Found{ TestInstances.find(AllLower(GroupName)) };
+        if(TestInstances.cend() == Found)
+            { return EXIT_FAILURE; }
+
+        // Send every result, the parent decides which ones it keeps.
+        UnitTestGroup& OneTestGroup = *Found->second;
+        OneTestGroup.OverrideSuccessDetails(true);
+        OneTestGroup.RunWithTestCases();
+        WriteTestResultRecords(OneTestGroup);
+        std::cout << OneTestGroup.GetTestLog();
+        return TestResult::Warning > OneTestGroup.GetWorstResults() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /// @brief Marks a ParallelTask that runs the body of a test group instead of one of its test cases.
+    const Mezzanine::SizeType NoTestCase{ std::numeric_limits<Mezzanine::SizeType>::max() };
+
+    /// @brief One piece of work for the worker pool, either the body of a test group or one of its test cases.
+    struct ParallelTask
+    {
+        /// @brief Which ParallelTestGroup this is part of.
+        Mezzanine::SizeType GroupIndex;
+        /// @brief Which test case of that group this runs, or NoTestCase for the group itself.
+        Mezzanine::SizeType CaseIndex;
+    };
+
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wpadded")
+    /// @brief A test group whose body and test cases are spread across workers, and how far along it is.
+    /// @details The parts of a group only touch their own slot in FinishedCases and the atomic counters, so they
+    /// never wait on each other. Whichever part finishes last gathers up the group.
+    struct ParallelTestGroup
+    {
+        /// @brief The group being run.
+        UnitTestGroup& Group;
+        /// @brief Test cases that have finished, in the order they were declared, they wait here for the group.
+        std::vector<std::unique_ptr<UnitTestGroup>> FinishedCases;
+        /// @brief How many of the tasks for this group have not yet finished.
+        std::atomic<Mezzanine::SizeType> TasksLeft;
+        /// @brief The nanoseconds every finished task for this group took, added together.
+        std::atomic<std::chrono::nanoseconds::rep> TimeSpent{0};
+
+        /// @brief Prepare to track one test group.
+        /// @param ToRun The group being run.
+        /// @param CaseCount How many of its test cases will be run as tasks of their own.
+        ParallelTestGroup(UnitTestGroup& ToRun, const Mezzanine::SizeType CaseCount)
+            : Group(ToRun), FinishedCases(CaseCount), TasksLeft(CaseCount + 1)
+            {}
+    };
+    RESTORE_WARNING_STATE
+
+    /// @brief Read how long each test group may run from a count of seconds like "300" or "0.5".
+    /// @param Seconds The text after the timeout token.
+    /// @param Results Where to put the timeout.
+    /// @return True if the text was a positive count of seconds.
+    Mezzanine::Boole StringToTimeout(const Mezzanine::String& Seconds, ParsedCommandLineArgs& Results)
+    {
+        char* End = nullptr;
+        const double Parsed{ std::strtod(Seconds.c_str(), &End) };
+        if(Seconds.empty() || '\0' != *End || !(0.0 < Parsed) || 1e9 < Parsed) // 1e9 seconds is about 31 years.
+            { return false; }
+        Results.GroupTimeout =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(Parsed));
+        return std::chrono::nanoseconds::zero() < Results.GroupTimeout;
+    }
+
+    /// @brief Read the least severe result that stops a fail fast run from text like "warning".
+    /// @param Severity The text after the fail fast token, already in lower case.
+    /// @param Results Where to put the severity.
+    /// @return True if the text named a result.
+    Mezzanine::Boole StringToFailFastSeverity(const Mezzanine::String& Severity, ParsedCommandLineArgs& Results)
+    {
+        const Mezzanine::UInt32 Highest{ static_cast<Mezzanine::UInt32>(TestResult::Highest) };
+        for(Mezzanine::UInt32 ResultInt = 0; ResultInt <= Highest; ResultInt++)
+        {
+            if(AllLower(Mezzanine::String(TestResultToString(IntToTestResult(ResultInt)))) == Severity)
             {
-                case '&':   Sanitized.append("&amp;"); break;
-                case '<':   Sanitized.append("&lt;"); break;
-                case '>':   Sanitized.append("&gt;"); break;
-                case '"':   Sanitized.append("&quot;"); break;
-                case '\'':  Sanitized.append("&apos;"); break;
-                default:    Sanitized.append(1, CurrChar); break;
+                Results.FailFast = true;
+                Results.FailFastSeverity = IntToTestResult(ResultInt);
+                return true;
             }
         }
-        return Sanitized;
+        return false;
+    }
+
+    /// @brief Has a fail fast run been stopped, so nothing else should be started?
+    /// @param Options The parsed command line.
+    /// @return True if this is a fail fast run and it was tripped.
+    Mezzanine::Boole RunCancelled(const ParsedCommandLineArgs& Options)
+        { return nullptr != Options.CancelTrigger && Options.CancelTrigger->IsTripped(); }
+
+    /// @brief Record that a test group did not finish before a fail fast run was stopped.
+    /// @details Groups with a result bad enough to stop the run are what stopped it, so they are left as they are.
+    /// Every other group that finishes after the run was stopped, or never started, might be missing results.
+    /// @param Options The parsed command line.
+    /// @param Group A test group that just finished or was never started.
+    void MarkIfCancelled(const ParsedCommandLineArgs& Options, UnitTestGroup& Group)
+    {
+        if(!RunCancelled(Options) || Options.CancelTrigger->GetSeverity() <= Group.GetWorstResults())
+            { return; }
+        Group.AddTestResultWithoutName(TestData(Group.Name() + "::" + CancelledTestName, TestResult::Cancelled));
+    }
+
+    /// @brief How long a test group may run, its own timeout if it has one or the one from the command line.
+    /// @param Options The parsed command line.
+    /// @param Group The test group about to run.
+    /// @return The timeout, zero if there is none.
+    std::chrono::nanoseconds TimeoutFor(const ParsedCommandLineArgs& Options, const UnitTestGroup& Group)
+    {
+        const std::chrono::nanoseconds OwnTimeout{ Group.Timeout() };
+        return std::chrono::nanoseconds::zero() < OwnTimeout ? OwnTimeout : Options.GroupTimeout;
+    }
+
+    /// @brief Make the result recorded for a test group that ran out of time.
+    /// @details A result has nowhere else to put a message, so how long the group ran goes where the function
+    /// would be.
+    /// @param Group The test group that ran out of time.
+    /// @param Elapsed How long it had been running.
+    /// @return An Unknown result named after the group and TimeoutTestName.
+    TestData TimeoutResult(const UnitTestGroup& Group, const std::chrono::nanoseconds Elapsed)
+    {
+        return TestData(Group.Name() + "::" + TimeoutTestName, TestResult::Unknown,
+                        "timed out after " + std::to_string(std::chrono::duration<double>(Elapsed).count()) +
+                        " seconds");
+    }
+
+    /// @brief How long a run being abandoned waits for the reporters before exiting anyway.
+    const std::chrono::seconds AbandonedReportTimeout{ 5 };
+
+    /// @brief End the run because a test group running in this process took longer than its timeout.
+    /// @details A thread cannot be stopped from outside and the group may hold locks or memory others need, so
+    /// waiting for it could take forever. Instead it is recorded as Unknown, after every group that finished, and
+    /// the Junit XML and summary are written from those before the process exits without waiting for anything
+    /// else. The duration and incremental histories are left as they were, this run did not finish. Reporters are
+    /// only ever called from the reporter thread, where a worker's results may still be in progress, so the timeout
+    /// is queued behind those and the reporters get a limited time to finish.
+    /// @param Options The parsed command line, for the reporter and what to write.
+    /// @param Finished Every group that finished so far.
+    /// @param Group The test group that ran out of time.
+    /// @param Elapsed How long it had been running.
+    [[noreturn]]
+    void AbandonHungRun(const ParsedCommandLineArgs& Options,
+                        FinishedTestGroups& Finished,
+                        const UnitTestGroup& Group,
+                        const std::chrono::nanoseconds Elapsed)
+    {
+        std::cerr << "Test group '" << Group.Name() << "' was still running after " << PrettyDurationString(Elapsed)
+                  << " and cannot be stopped in this process, ending the run." << std::endl;
+
+        UnitTestGroup::TestDataStorageType AllResults;
+        std::vector<NamedDuration> TestTimings;
+        UnstoredSuccessCounts UnstoredSuccesses;
+        Finished.TakeAll(AllResults, TestTimings, UnstoredSuccesses);
+        AllResults.push_back(TimeoutResult(Group, Elapsed));
+        TestTimings.push_back( {Group.Name() + (Group.CanBeParallel() ? ParallelTimingSuffix : SerialTimingSuffix),
+                                Elapsed} );
+        const Mezzanine::Whole TotalUnstored{ TotalUnstoredSuccesses(UnstoredSuccesses) };
+
+        if(nullptr != Options.Reporter)
+        {
+            Options.Reporter->ReportResults(AllResults.cend() - 1, AllResults.cend());
+            if(!Options.Reporter->EndRunWithin(TotalUnstored, AbandonedReportTimeout))
+                { std::cerr << "The reporters did not finish in time, their output may be incomplete." << std::endl; }
+        }
+        std::cout << AllResults.back();
+        if(Options.EmitJunitXml)
+            { EmitJunitResults(AllResults, ShardFileName(JunitFileName, Options), UnstoredSuccesses, TestTimings); }
+        if(!Options.SkipSummary)
+        {
+            std::cout << "\n";
+            RenderTestResultSummary(AllResults, std::cout, TotalUnstored);
+        }
+        std::cout << std::flush;
+        std::_Exit(EXIT_FAILURE);
+    }
+
+    /// @brief Watches one piece of a test group that runs in this process for as long as this exists.
+    class ScopedHangWatch
+    {
+        private:
+            /// @brief The watchdog to use, if null nothing is watched.
+            Watchdog* HangWatch;
+            /// @brief What the watchdog returned when watching started.
+            Mezzanine::SizeType WatchID{0};
+
+        public:
+            /// @brief Start watching.
+            /// @param Watcher The watchdog to use, if null nothing is watched.
+            /// @param Options The parsed command line, for the timeout and what to write if the run is abandoned.
+            /// @param Finished Every group that finished so far, written out if the run is abandoned.
+            /// @param Group The test group about to run.
+            ScopedHangWatch(Watchdog* Watcher,
+                            const ParsedCommandLineArgs& Options,
+                            FinishedTestGroups& Finished,
+                            const UnitTestGroup& Group)
+                : HangWatch(Watcher)
+            {
+                if(nullptr != HangWatch)
+                {
+                    WatchID = HangWatch->Start(TimeoutFor(Options, Group),
+                                               [&Options, &Finished, &Group](const std::chrono::nanoseconds Elapsed)
+                                                   { AbandonHungRun(Options, Finished, Group, Elapsed); });
+                }
+            }
+            /// @brief Stop watching, the piece of the group is done.
+            ~ScopedHangWatch()
+            {
+                if(nullptr != HangWatch)
+                    { HangWatch->Stop(WatchID); }
+            }
+            /// @brief Deleted copy constructor, watching only stops once.
+            ScopedHangWatch(const ScopedHangWatch&) = delete;
+            /// @brief Deleted copy assignment, watching only stops once.
+            ScopedHangWatch& operator=(const ScopedHangWatch&) = delete;
+    };
+
+    /// @brief Make a watchdog for test groups run in this process, but only if any of them could time out.
+    /// @details A process running a single group for its parent is stopped by that parent, so it never needs one.
+    /// @param Options The parsed command line.
+    /// @return The watchdog, or null if nothing needs watching.
+    std::unique_ptr<Watchdog> CreateHangWatch(const ParsedCommandLineArgs& Options)
+    {
+        const Mezzanine::Boole AnyTimeouts{ std::any_of(Options.TestsToRun.cbegin(), Options.TestsToRun.cend(),
+            [&Options](const UnitTestGroup* OneTest)
+                { return std::chrono::nanoseconds::zero() < TimeoutFor(Options, *OneTest); }) };
+        if(Options.InSubProcess || !AnyTimeouts)
+            { return nullptr; }
+        return std::make_unique<Watchdog>();
+    }
+
+    /// @brief Read the shard to run from text like "1/4".
+    /// @param Shard The text after the shard token.
+    /// @param Results Where to put the shard index and count.
+    /// @return True if the text was a valid shard.
+    Mezzanine::Boole StringToShard(const Mezzanine::String& Shard, ParsedCommandLineArgs& Results)
+    {
+        const Mezzanine::String::size_type Slash{ Shard.find('/') };
+        if(Mezzanine::String::npos == Slash)
+            { return false; }
+        const Mezzanine::String Index{ Shard.substr(0, Slash) };
+        const Mezzanine::String Count{ Shard.substr(Slash + 1) };
+        if(Index.empty() || Mezzanine::String::npos != Index.find_first_not_of("0123456789"))
+            { return false; }
+        Results.ShardIndex = static_cast<Mezzanine::Whole>(std::strtoul(Index.c_str(), nullptr, 10));
+        Results.ShardCount = StringToWorkerCount(Count);
+        return Results.ShardIndex < Results.ShardCount;
     }
 
     CallingTableType CreateMainArgsCallingTable(const CoreTestGroup& TestInstances, ParsedCommandLineArgs& Results)
@@ -83,8 +406,13 @@ namespace
         CallingTable[HelpToken] = [&Results]() noexcept { Results.ExitWithError = EXIT_FAILURE; };
         CallingTable[RunInThisProcessToken] = [&Results]() noexcept { Results.InSubProcess = true; };
         CallingTable[NoThreads] = [&Results]() noexcept { Results.ForceSingleThread = true; };
+        CallingTable[ZygoteToken] = [&Results]() noexcept { Results.UseZygote = true; };
+        CallingTable[BinaryResultsToken] = [&Results]() noexcept { Results.BinaryResults = true; };
         CallingTable[JunitXMLAToken] = [&Results]() noexcept { Results.EmitJunitXml = true; };
         CallingTable[JunitXMLBToken] = [&Results]() noexcept { Results.EmitJunitXml = true; };
+        CallingTable[JsonLinesToken] = [&Results]() noexcept { Results.EmitJsonLines = true; };
+        CallingTable[TapToken] = [&Results]() noexcept { Results.EmitTap = true; };
+        CallingTable[FailFastToken] = [&Results]() noexcept { Results.FailFast = true; };
 
         // Debug does both Single thread and Single process.
         auto RunHere = [&Results]() noexcept { Results.InSubProcess = true; Results.ForceSingleThread = true; };
@@ -112,6 +440,9 @@ namespace
 
         CallingTable[SkipSummaryToken] = [&Results]() noexcept { Results.SkipSummary = true; };
         CallingTable[SkipFileToken] = [&Results]() noexcept { Results.SkipFile = true; };
+        CallingTable[SkipHistoryToken] = [&Results]() noexcept { Results.SkipHistory = true; };
+        CallingTable[IncrementalToken] = [&Results]() noexcept { Results.Incremental = true; };
+        CallingTable[FailuresOnlyToken] = [&Results]() noexcept { Results.FailuresOnly = true; };
         CallingTable[DoBenchmarkToken] = [&Results]() noexcept { Results.DoBenchmark = true; };
 
         return CallingTable;
@@ -129,6 +460,14 @@ namespace Mezzanine
 {
     namespace Testing
     {
+        std::vector<Mezzanine::String> ExpandCommandLine(int argc, char** argv)
+        {
+            std::vector<Mezzanine::String> Expanded;
+            for (int c=1; c<argc; ++c)
+                { AppendArgument(argv[c], Expanded, 0); }
+            return Expanded;
+        }
+
         ParsedCommandLineArgs DealWithdCommandLineArgs(int argc, char** argv, const CoreTestGroup& TestInstances)
         {
             ParsedCommandLineArgs Results;
@@ -138,28 +477,94 @@ namespace Mezzanine
             else
                 { Results.ExitWithError = EXIT_FAILURE; }
 
+            std::vector<Mezzanine::String> Args;
+            try
+                { Args = ExpandCommandLine(argc, argv); }
+            catch(const std::runtime_error& Failure)
+            {
+                std::cerr << Failure.what() << std::endl;
+                Results.ExitWithError = EXIT_FAILURE;
+            }
+
             // Construct a delegation table that can take a huge variety of actions based on strings.
             CallingTableType CallingTable = CreateMainArgsCallingTable(TestInstances, Results);
 
-            // Loop over the argv and make a decision for each arg.
-            for (int c=1; c<argc; ++c)
+            // Patterns are only gathered here and checked against each group once after every arg is read.
+            TestGroupMatcher Included;
+            TestGroupMatcher Excluded;
+            const auto AddRegex = [&Results](TestGroupMatcher& Matcher, const Mezzanine::String& Regex)
+            {
+                try
+                    { Matcher.AddRegex(Regex); }
+                catch(const std::regex_error&)
+                {
+                    std::cerr << "Argument '" << Regex << "' is not a valid regular expression." << std::endl;
+                    Results.ExitWithError = EXIT_FAILURE;
+                }
+            };
+
+            // Loop over the args and make a decision for each arg.
+            for (SizeType c=0; c<Args.size(); ++c)
             {
                 if(EXIT_SUCCESS != Results.ExitWithError) { break; } // Something bogus bail
-                const Mezzanine::String ThisArg(AllLower(argv[c]));           // Insure case insensitivity
+                const Mezzanine::String ThisArg(AllLower(Args[c]));          // Insure case insensitivity
                 if(CallingTable.count(ThisArg))                               // check for keywords that aren't tests.
                     { CallingTable[ThisArg](); }
                 else if(TestInstances.count(ThisArg)) // Wasn't a keyword, could it be a test?
                     { Results.TestsToRun.push_back(TestInstances.at(ThisArg)); }
-                else if(ThisArg.size()>SkipTestToken.size() &&
-                        TestInstances.count(ThisArg.substr(SkipTestToken.size())))
-                {
-                    auto FilterTestByName =
-                        [&](UnitTestGroup* T){ return ThisArg.substr(SkipTestToken.size()) == AllLower(T->Name()); };
-                    Results.TestsToRun.erase(
-                        std::remove_if(Results.TestsToRun.begin(), Results.TestsToRun.end(), FilterTestByName),
-                        Results.TestsToRun.end()
-                    );
+                else if(0 == ThisArg.compare(0, WorkerCountToken.size(), WorkerCountToken)) // Either "-j 4" or "-j4"
+                {
+                    Mezzanine::String Count(ThisArg.substr(WorkerCountToken.size()));
+                    if(Count.empty() && c+1 < Args.size())
+                        { Count = Args[++c]; }
+                    Results.WorkerCount = StringToWorkerCount(Count);
+                    if(0 == Results.WorkerCount)
+                    {
+                        std::cerr << "Argument '" << WorkerCountToken << "' needs a positive count of workers, not '"
+                                  << Count << "'." << std::endl;
+                        Results.ExitWithError = EXIT_FAILURE;
+                    }
+                }
+                else if(0 == ThisArg.compare(0, ShardToken.size(), ShardToken)) // Like "shard=0/4"
+                {
+                    if(!StringToShard(ThisArg.substr(ShardToken.size()), Results))
+                    {
+                        std::cerr << "Argument '" << ThisArg << "' needs a shard index less than a positive count of "
+                                  << "shards, like '" << ShardToken << "0/4'." << std::endl;
+                        Results.ExitWithError = EXIT_FAILURE;
+                    }
+                }
+                else if(0 == ThisArg.compare(0, ShardHistoryToken.size(), ShardHistoryToken))
+                    { Results.ShardHistoryFileName = Args[c].substr(ShardHistoryToken.size()); } // Keeps the case.
+                else if(0 == ThisArg.compare(0, FailFastAtToken.size(), FailFastAtToken)) // Like "failfast=warning"
+                {
+                    if(!StringToFailFastSeverity(ThisArg.substr(FailFastAtToken.size()), Results))
+                    {
+                        std::cerr << "Argument '" << ThisArg << "' needs the name of a test result, like '"
+                                  << FailFastAtToken << "warning'." << std::endl;
+                        Results.ExitWithError = EXIT_FAILURE;
+                    }
+                }
+                else if(0 == ThisArg.compare(0, TimeoutToken.size(), TimeoutToken)) // Like "timeout=300"
+                {
+                    if(!StringToTimeout(ThisArg.substr(TimeoutToken.size()), Results))
+                    {
+                        std::cerr << "Argument '" << ThisArg << "' needs a positive count of seconds, like '"
+                                  << TimeoutToken << "300'." << std::endl;
+                        Results.ExitWithError = EXIT_FAILURE;
+                    }
                 }
+                else if(0 == ThisArg.compare(0, RegexToken.size(), RegexToken)) // Like "regex=phys.*"
+                    { AddRegex(Included, Args[c].substr(RegexToken.size())); }
+                else if(0 == ThisArg.compare(0, SkipTestToken.size() + RegexToken.size(), SkipTestToken + RegexToken))
+                    { AddRegex(Excluded, Args[c].substr(SkipTestToken.size() + RegexToken.size())); }
+                else if(ThisArg.size()>SkipTestToken.size() &&
+                        0 == ThisArg.compare(0, SkipTestToken.size(), SkipTestToken) &&
+                        (TestInstances.count(ThisArg.substr(SkipTestToken.size())) ||
+                         TestGroupMatcher::IsGlob(ThisArg)))
+                    { Excluded.AddNameOrGlob(ThisArg.substr(SkipTestToken.size())); }
+                else if(TestGroupMatcher::IsGlob(ThisArg)) // Like "phys*"
+                    { Included.AddGlob(ThisArg); }
                 else
                 {
                     std::cerr << ThisArg.substr(SkipTestToken.size()) << std::endl
@@ -168,19 +573,99 @@ namespace Mezzanine
                 }
             }
 
-            if(0==Results.TestsToRun.size())
+            if(!Included.Empty())
+            {
+                for(const CoreTestGroup::value_type& OneTest : TestInstances)
+                    { if(Included.Matches(OneTest.first)) { Results.TestsToRun.push_back(OneTest.second); } }
+            }
+            else if(0==Results.TestsToRun.size())
                 { CallingTable[AllToken](); }
 
+            // One pass drops skipped groups and groups selected more than once, however many of either there are.
+            std::unordered_set<UnitTestGroup*> Skipped;
+            if(!Excluded.Empty())
+            {
+                for(const CoreTestGroup::value_type& OneTest : TestInstances)
+                    { if(Excluded.Matches(OneTest.first)) { Skipped.insert(OneTest.second); } }
+            }
+            std::unordered_set<UnitTestGroup*> Seen;
+            Results.TestsToRun.erase(
+                std::remove_if(Results.TestsToRun.begin(), Results.TestsToRun.end(),
+                               [&Skipped, &Seen](UnitTestGroup* T)
+                                   { return Skipped.count(T) || !Seen.insert(T).second; }),
+                Results.TestsToRun.end()
+            );
+
+            if(0==Results.WorkerCount)
+                { Results.WorkerCount = GetAvailableConcurrency(); }
+
             if(EXIT_SUCCESS != Results.ExitWithError) { Usage(Results.CommandName, TestInstances); }
             return Results;
         }
 
+        CoreTestGroup CreateSelectedTestGroups(int argc,
+                                               char** argv,
+                                               const CoreTestGroup& TestInstances,
+                                               std::vector<std::unique_ptr<UnitTestGroup>>& CreatedGroups)
+        {
+            const TestGroupFactoryMap& Registered = RegisteredTestGroups();
+
+            // Groups named to be skipped must still exist for their skip argument to be valid.
+            // Patterns to include could match any group, only patterns to skip can be used without creating them all.
+            std::vector<Mezzanine::String> Named;
+            Boole NamesGroupsToRun{false};
+            Boole NeedsEveryGroup{false};
+            std::vector<Mezzanine::String> Args;
+            try
+                { Args = ExpandCommandLine(argc, argv); }
+            catch(const std::runtime_error&)
+                { NeedsEveryGroup = true; } // So the error is reported with every group in the usage.
+            for(const Mezzanine::String& OneArg : Args)
+            {
+                const Mezzanine::String ThisArg(AllLower(OneArg));
+                if(AllToken == ThisArg || AutomaticToken == ThisArg ||
+                   InteractiveToken == ThisArg || HelpToken == ThisArg ||
+                   0 == ThisArg.compare(0, RegexToken.size(), RegexToken) ||
+                   (TestGroupMatcher::IsGlob(ThisArg) && 0 != ThisArg.compare(0, SkipTestToken.size(), SkipTestToken)))
+                    { NeedsEveryGroup = true; }
+                else if(Registered.count(ThisArg))
+                {
+                    Named.push_back(ThisArg);
+                    NamesGroupsToRun = true;
+                }
+                else if(0 == ThisArg.compare(0, SkipTestToken.size(), SkipTestToken) &&
+                        Registered.count(ThisArg.substr(SkipTestToken.size())))
+                    { Named.push_back(ThisArg.substr(SkipTestToken.size())); }
+            }
+
+            CoreTestGroup Results{TestInstances};
+            const auto Create = [&Results, &CreatedGroups](const TestGroupFactoryMap::value_type& OneFactory)
+            {
+                if(Results.count(OneFactory.first))
+                    { return; }
+                CreatedGroups.push_back(OneFactory.second());
+                Results.insert(CoreTestGroupEntry(OneFactory.first, CreatedGroups.back().get()));
+            };
+
+            if(NeedsEveryGroup || !NamesGroupsToRun)
+            {
+                for(const TestGroupFactoryMap::value_type& OneFactory : Registered)
+                    { Create(OneFactory); }
+            } else {
+                for(const Mezzanine::String& OneName : Named)
+                    { Create(*Registered.find(OneName)); }
+            }
+            return Results;
+        }
+
         TestResult RenderTestResultSummary(const UnitTestGroup::TestDataStorageType& AllResults,
-                                           std::ostream& SummaryStream)
+                                           std::ostream& SummaryStream,
+                                           const Whole UnstoredSuccesses)
         {
-            std::vector<Mezzanine::Int32> ResultsSummary(TestResultToUnsignedInt(TestResult::Highest)+1, 0);
+            std::vector<Whole> ResultsSummary(TestResultToUnsignedInt(TestResult::Highest)+1, 0);
             for(const TestData& OneResult : AllResults)
                 { ResultsSummary[TestResultToUnsignedInt(OneResult.Results)]++; }
+            ResultsSummary[TestResultToUnsignedInt(TestResult::Success)] += UnstoredSuccesses;
 
             SummaryStream << "    --= Summary =--\n";
             for(Mezzanine::UInt32 ResultInt = 0; IntToTestResult(ResultInt)<=TestResult::Highest; ResultInt++)
@@ -190,7 +675,8 @@ namespace Mezzanine
             }
 
             TestResult Worst = GetWorstResults(AllResults);
-            SummaryStream << "\n  From " << AllResults.size() << " tests the worst result is: " << Worst << '\n';
+            SummaryStream << "\n  From " << AllResults.size() + UnstoredSuccesses
+                          << " tests the worst result is: " << Worst << '\n';
 
             return Worst;
         }
@@ -212,75 +698,242 @@ namespace Mezzanine
         {
             if(Options.InSubProcess)
             {
-                OneTestGroup(); // Run tests and discard results, the parent process will grab it.
+                OneTestGroup.OverrideSuccessDetails(true); // Send every result, the parent decides what to keep.
+                OneTestGroup.RunWithTestCases(); // Run tests and discard results, the parent process will grab it.
+                if(Options.BinaryResults)
+                    { WriteTestResultRecords(OneTestGroup); }
             } else {
-                String Command = Options.CommandName + " " +
-                                 OneTestGroup.Name() + " " +
-                                 RunInThisProcessToken + " " +
-                                 SkipSummaryToken;
-                String ProcessLog = RunCommand(Command).ConsoleOutput;
-                std::istringstream LogStream(ProcessLog);
-                Mezzanine::String OneLine;
-                while( std::getline(LogStream, OneLine) )
-                {
-                    TestData PossibleResults( StringToTestData(OneLine) );
+                // Where possible results come back as binary records, which are much cheaper to read than the log.
+                // Either way results are taken as they arrive, so only a partial record or line is ever held.
+                const Boole BinaryResults{ nullptr != Options.Zygote || ResultChannelIsSupported() };
+                String Pending;
+                // A bad record cannot be skipped, so everything after it is drained unread and the child is still
+                // waited on. Throwing out of these callbacks would leave the child running and unreaped.
+                String CorruptReason;
+                const auto AddRecords = [&OneTestGroup, &CorruptReason](Mezzanine::StringView Available)
+                {
+                    if(!CorruptReason.empty())
+                        { return Mezzanine::SizeType{Available.size()}; }
+                    TestDataView OneRecord;
+                    Mezzanine::SizeType RecordSize{0};
+                    try
+                        { RecordSize = ReadTestDataRecord(Available, OneRecord); }
+                    catch(const std::runtime_error& Failure)
+                    {
+                        CorruptReason = Failure.what();
+                        return Mezzanine::SizeType{Available.size()};
+                    }
+                    if(0 != RecordSize)
+                        { OneTestGroup.AddTestResultWithoutName(OneRecord.ToTestData(SubProcessPrefix)); }
+                    return RecordSize;
+                };
+                const auto AddLine = [&OneTestGroup](Mezzanine::StringView OneLine)
+                {
+                    TestData PossibleResults( StringToTestData(String(OneLine)) );
                     if(TestData{} != PossibleResults)
                     {
-                        PossibleResults.TestName = "SubProcess::" + PossibleResults.TestName;
+                        PossibleResults.TestName = SubProcessPrefix + PossibleResults.TestName;
                         OneTestGroup.AddTestResultWithoutName(std::move(PossibleResults));
                     }
+                };
+                const auto AddLines = [&AddLine](Mezzanine::StringView Available)
+                {
+                    const Mezzanine::StringView::size_type LineEnd{ Available.find('\n') };
+                    if(Mezzanine::StringView::npos == LineEnd)
+                        { return Mezzanine::SizeType{0}; }
+                    AddLine(Available.substr(0, LineEnd));
+                    return Mezzanine::SizeType{LineEnd + 1};
+                };
+
+                CommandOutputCallback OnConsoleOutput;
+                CommandOutputCallback OnResultChannel;
+                if(BinaryResults)
+                {
+                    OnConsoleOutput = [](Mezzanine::StringView) {}; // Only the records matter.
+                    OnResultChannel = [&Pending, &AddRecords](Mezzanine::StringView Chunk)
+                        { ParseStreamChunk(Pending, Chunk, AddRecords); };
+                } else {
+                    OnConsoleOutput = [&Pending, &AddLines](Mezzanine::StringView Chunk)
+                        { ParseStreamChunk(Pending, Chunk, AddLines); };
+                }
+
+                const std::chrono::nanoseconds Timeout{ TimeoutFor(Options, OneTestGroup) };
+                const std::atomic<Boole>* Cancel{
+                    nullptr == Options.CancelTrigger ? nullptr : &Options.CancelTrigger->GetTrippedFlag() };
+                TestTimer ChildTimer;
+                Mezzanine::Integer ChildExitCode{EXIT_SUCCESS};
+                if(nullptr != Options.Zygote)
+                {
+                    ChildExitCode = Options.Zygote->RunInChildStreaming(OneTestGroup.Name(),
+                                                                        OnConsoleOutput,
+                                                                        OnResultChannel,
+                                                                        Timeout,
+                                                                        Cancel);
+                } else {
+                    String Command = Options.CommandName + " " +
+                                     OneTestGroup.Name() + " " +
+                                     RunInThisProcessToken + " " +
+                                     SkipSummaryToken;
+                    if(BinaryResults)
+                        { Command += " " + BinaryResultsToken; }
+                    ChildExitCode = RunCommandStreaming(Command, OnConsoleOutput, OnResultChannel, Timeout, Cancel);
+                }
+
+                // A last line might not have a newline, but a partial record is all that is left of a crash.
+                if(!BinaryResults && !Pending.empty())
+                    { AddLine(Pending); }
+                if(BinaryResults && !Pending.empty() && CorruptReason.empty())
+                {
+                    CorruptReason = "the last " + std::to_string(Pending.size()) +
+                                    " bytes are only part of a result record";
+                }
+
+                if(!CorruptReason.empty())
+                {
+                    std::cerr << "Test group '" << OneTestGroup.Name() << "' sent results that could not be read: "
+                              << CorruptReason << std::endl;
+                    OneTestGroup.AddTestResultWithoutName(
+                        TestData(OneTestGroup.Name() + "::" + CorruptResultsTestName, TestResult::Failed));
+                }
+
+                // MarkIfCancelled skips groups whose results stopped the run, but one whose own results stopped it
+                // was killed too and did not finish.
+                if(CancelledExitCode == ChildExitCode &&
+                   Options.CancelTrigger->GetSeverity() <= OneTestGroup.GetWorstResults())
+                {
+                    OneTestGroup.AddTestResultWithoutName(
+                        TestData(OneTestGroup.Name() + "::" + CancelledTestName, TestResult::Cancelled));
+                }
+
+                // Whatever the child reported before it was killed is kept, so it is clear how far it got.
+                if(TimedOutExitCode == ChildExitCode)
+                {
+                    std::cerr << "Test group '" << OneTestGroup.Name() << "' was killed after running for "
+                              << PrettyDurationString(ChildTimer.GetLength()) << "." << std::endl;
+                    OneTestGroup.AddTestResultWithoutName(TimeoutResult(OneTestGroup, ChildTimer.GetLength()));
                 }
             }
         }
 
-        void RunParallelThreads(const ParsedCommandLineArgs& Options,
-                                UnitTestGroup::TestDataStorageType& AllResults,
-                                std::vector<NamedDuration>& TestTimings)
+        Whole TotalUnstoredSuccesses(const UnstoredSuccessCounts& PerGroup)
+        {
+            Whole Total{0};
+            for(const UnstoredSuccessCounts::value_type& OneGroup : PerGroup)
+                { Total += OneGroup.second; }
+            return Total;
+        }
+
+        FinishedTestGroups::FinishedTestGroups(UnitTestGroup::TestDataStorageType Earlier)
+            : Results(std::move(Earlier))
+            {}
+
+        void FinishedTestGroups::Add(UnitTestGroup& Group, NamedDuration Timing)
+        {
+            UnitTestGroup::TestDataStorageType GroupResults{ Group.TakeTestResults() };
+            std::lock_guard<std::mutex> Lock(FinishedMutex);
+            Results.insert(Results.end(),
+                           std::make_move_iterator(GroupResults.begin()),
+                           std::make_move_iterator(GroupResults.end()));
+            Timings.push_back(std::move(Timing));
+            if(0 != Group.GetUnstoredSuccessCount())
+                { UnstoredSuccesses[Group.Name()] += Group.GetUnstoredSuccessCount(); }
+        }
+
+        void FinishedTestGroups::TakeAll(UnitTestGroup::TestDataStorageType& AllResults,
+                                         std::vector<NamedDuration>& TestTimings,
+                                         UnstoredSuccessCounts& AllUnstoredSuccesses)
         {
-            std::mutex ResultsMutex;
-            std::vector<std::thread> TestThreads;
+            std::lock_guard<std::mutex> Lock(FinishedMutex);
+            AllResults.insert(AllResults.end(),
+                              std::make_move_iterator(Results.begin()),
+                              std::make_move_iterator(Results.end()));
+            TestTimings.insert(TestTimings.end(),
+                               std::make_move_iterator(Timings.begin()),
+                               std::make_move_iterator(Timings.end()));
+            for(const UnstoredSuccessCounts::value_type& OneGroup : UnstoredSuccesses)
+                { AllUnstoredSuccesses[OneGroup.first] += OneGroup.second; }
+            Results.clear();
+            Timings.clear();
+            UnstoredSuccesses.clear();
+        }
 
+        void RunParallelThreads(const ParsedCommandLineArgs& Options, FinishedTestGroups& Finished)
+        {
+            // Queue up only the tests that love massive parallelism, the rest run when nothing else is. Test cases of
+            // groups that run in this process are queued separately, so one big group can use many workers.
+            std::deque<ParallelTestGroup> ParallelTests;
+            std::vector<ParallelTask> Tasks;
+            Tasks.reserve(Options.TestsToRun.size());
             for(UnitTestGroup* OneTestGroup : Options.TestsToRun)
             {
-                UnitTestGroup& TestGroupForThread = *(OneTestGroup);
+                if(OneTestGroup->MustBeSerialized())
+                    { continue; }
+                const SizeType CaseCount{ OneTestGroup->IsMultiThreadSafe() ? OneTestGroup->TestCases().size() : 0 };
+                Tasks.push_back( {ParallelTests.size(), NoTestCase} );
+                for(SizeType CaseIndex = 0; CaseIndex < CaseCount; CaseIndex++)
+                    { Tasks.push_back( {ParallelTests.size(), CaseIndex} ); }
+                ParallelTests.emplace_back(*OneTestGroup, CaseCount);
+            }
 
-                // Skip the ones that cannot be run here. Run only the tests that love massive parallelism.
-                if(TestGroupForThread.MustBeSerialized()) { continue; }
+            // Finished groups are only locked long enough to move their results in, and logs go to a thread of their
+            // own, so workers barely wait on each other or on the console.
+            const Whole WorkerCount{ Options.ForceSingleThread ? Whole{1} : Options.WorkerCount };
+            OutputWriter LogWriter(std::cout);
+            const std::unique_ptr<Watchdog> HangWatch{ CreateHangWatch(Options) };
 
-                // Store the test and any synchronization inside it.
-                auto DoAndTimeThisTest = [&]()
-                {
-                    // Multithreaded part
-                    TestTimer SingleThreadTimer;
-                    if(TestGroupForThread.IsMultiThreadSafe())
-                    {
-                        TestGroupForThread.operator()();
-                    } else {
-                        RunSubProcessTest(Options, TestGroupForThread);
-                    }
-
-                    // Synchronize with single threaded part.
-                    std::lock_guard<std::mutex> Lock(ResultsMutex);
-                    AllResults.insert(AllResults.end(), TestGroupForThread.begin(), TestGroupForThread.end());
-                    std::cout << TestGroupForThread.GetTestLog(); // Publish the Thread Specific TestLogs.
-                    TestTimings.emplace_back (SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + "-T "));
-                };
+            // Each worker pulls the next task from the queue, so there are never more threads or child processes
+            // than workers no matter how many test groups there are.
+            auto DoAndTimeThisTest = [&](Whole, SizeType TaskIndex)
+            {
+                const ParallelTask& Task = Tasks[TaskIndex];
+                ParallelTestGroup& Progress = ParallelTests[Task.GroupIndex];
+                UnitTestGroup& TestGroupForThread = Progress.Group;
 
-                // Run it here if forced or in a thread otherwise.
-                if(Options.ForceSingleThread)
-                    { DoAndTimeThisTest(); }
-                else
-                    { TestThreads.emplace_back(DoAndTimeThisTest); }
+                // Multithreaded part, nothing new is started once a fail fast run has been stopped.
+                TestTimer SingleThreadTimer;
+                std::unique_ptr<UnitTestGroup> OneTestCase;
+                if(RunCancelled(Options))
+                {
+                    // The group is marked cancelled when its last task finishes.
+                } else if(NoTestCase != Task.CaseIndex) {
+                    const ScopedHangWatch Watch(HangWatch.get(), Options, Finished, TestGroupForThread);
+                    OneTestCase = TestGroupForThread.CreateTestCase(Task.CaseIndex);
+                    OneTestCase->operator()();
+                } else if(TestGroupForThread.IsMultiThreadSafe()) {
+                    const ScopedHangWatch Watch(HangWatch.get(), Options, Finished, TestGroupForThread);
+                    TestGroupForThread.operator()();
+                } else {
+                    RunSubProcessTest(Options, TestGroupForThread);
+                }
+                Progress.TimeSpent += SingleThreadTimer.GetLength().count();
 
+                // Only the last part of the group to finish goes on. Counting down makes every other part's writes
+                // visible to it, so it can merge them without a lock.
+                if(OneTestCase)
+                    { Progress.FinishedCases[Task.CaseIndex] = std::move(OneTestCase); }
+                if(1 != Progress.TasksLeft--)
+                    { return; }
 
-            }
-            for(std::thread& OneTestThread : TestThreads) { OneTestThread.join(); }
+                for(const std::unique_ptr<UnitTestGroup>& FinishedCase : Progress.FinishedCases)
+                {
+                    if(FinishedCase)
+                        { TestGroupForThread.AddTestCaseResults(*FinishedCase); }
+                }
+                MarkIfCancelled(Options, TestGroupForThread);
+                LogWriter.Write(TestGroupForThread.GetTestLog()); // Publish the Thread Specific TestLogs.
+                if(nullptr != Options.Reporter)
+                    { Options.Reporter->ReportResults(TestGroupForThread.cbegin(), TestGroupForThread.cend()); }
+                Finished.Add(TestGroupForThread, {TestGroupForThread.Name() + ParallelTimingSuffix,
+                                                  std::chrono::nanoseconds{Progress.TimeSpent}});
+            };
+
+            // Run them all here if forced or on the pool of workers otherwise.
+            RunOnWorkerPool(WorkerCount, Tasks.size(), DoAndTimeThisTest);
         }
 
-        void RunSerializedTests(const ParsedCommandLineArgs& Options,
-                                UnitTestGroup::TestDataStorageType& AllResults,
-                                std::vector<NamedDuration>& TestTimings)
+        void RunSerializedTests(const ParsedCommandLineArgs& Options, FinishedTestGroups& Finished)
         {
+            const std::unique_ptr<Watchdog> HangWatch{ CreateHangWatch(Options) };
             for(UnitTestGroup* OneTestGroup : Options.TestsToRun)
             {
                 UnitTestGroup& TestGroupForThread = *(OneTestGroup);
@@ -288,76 +941,146 @@ namespace Mezzanine
                 // Skip the ones that cannot be run here because they can't stand parrellelism.
                 if(TestGroupForThread.CanBeParallel()) { continue; }
 
-                // Run all of the rest tests right here.
+                // Run all of the rest tests right here, unless a fail fast run has been stopped.
                 TestTimer SingleThreadTimer;
 
-                if(TestGroupForThread.IsMultiProcessSafe())
+                if(RunCancelled(Options))
+                {
+                    // Nothing is started, it is marked cancelled below.
+                } else if(TestGroupForThread.IsMultiProcessSafe())
                 {
                     RunSubProcessTest(Options, TestGroupForThread);
                 } else {
                     // @todo expand the UnitTestGroup class to make this more specific
                     if(Options.DoBenchmark)
-                        { TestGroupForThread.operator()(); }
+                    {
+                        const ScopedHangWatch Watch(HangWatch.get(), Options, Finished, TestGroupForThread);
+                        TestGroupForThread.RunWithTestCases();
+                    }
                 }
 
                 // Synchronize with single threaded part.
-                AllResults.insert(AllResults.end(), TestGroupForThread.begin(), TestGroupForThread.end());
+                MarkIfCancelled(Options, TestGroupForThread);
+                if(nullptr != Options.Reporter)
+                    { Options.Reporter->ReportResults(TestGroupForThread.cbegin(), TestGroupForThread.cend()); }
                 std::cout << TestGroupForThread.GetTestLog(); // Publish the Test Specific Logs.
-                TestTimings.emplace_back (SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + "-S "));
-
+                Finished.Add(TestGroupForThread,
+                             SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + SerialTimingSuffix));
             }
         }
 
 
-        void EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults)
+        String ShardFileName(const String& FileName, const ParsedCommandLineArgs& Options)
         {
-            std::stringstream XmlContents;
-            XmlContents << "<testsuite tests=\"" << AllResults.size() << "\">\n";
-            for(UnitTestGroup::TestDataStorageType::value_type OneResult : AllResults)
+            if(1 >= Options.ShardCount)
+                { return FileName; }
+            const String Shard{ "-shard" + std::to_string(Options.ShardIndex) + "of" +
+                                std::to_string(Options.ShardCount) };
+            const String::size_type Extension{ FileName.rfind('.') };
+            if(String::npos == Extension)
+                { return FileName + Shard; }
+            return FileName.substr(0, Extension) + Shard + FileName.substr(Extension);
+        }
+
+        void EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults,
+                              const String& FileName,
+                              const UnstoredSuccessCounts& UnstoredSuccesses,
+                              const std::vector<NamedDuration>& TestTimings)
+        {
+            // How long each group took, by the name of the group without the suffix saying how it ran.
+            std::unordered_map<String, std::chrono::nanoseconds> GroupTimes;
+            for(const NamedDuration& OneTiming : TestTimings)
             {
-                switch(OneResult.Results)
-                {
-                    case TestResult::Success:
-                        XmlContents << "    <testcase classname=\"" << OneResult.FileName<< "\" name=\""
-                                        << SanitizeTestNameForJunit(OneResult.TestName) << "\" />\n";
-                        break;
-
-                    case TestResult::Skipped:
-                        XmlContents << "    <testcase classname=\"" << OneResult.FileName<< "\" name=\""
-                                        << SanitizeTestNameForJunit(OneResult.TestName) << "\">\n"
-                                    << "        <skipped />\n"
-                                    << "    </testcase>\n";
-                        break;
-
-                    case TestResult::Cancelled:
-                    case TestResult::Failed:
-                    case TestResult::Inconclusive:
-                    case TestResult::NotApplicable:
-                    case TestResult::Unknown:
-                    case TestResult::Warning:
-                    case TestResult::NonPerformant:
-                        XmlContents << "    <testcase classname=\"" << OneResult.FileName<< "\" name=\""
-                                        << SanitizeTestNameForJunit(OneResult.TestName) << "\">\n"
-                                    << "        <failure type=\"" << OneResult.Results << "\">\n"
-                                    << "            " << OneResult
-                                    << "        </failure>\n"
-                                    << "    </testcase>\n";
+                for(const String& Suffix : {ParallelTimingSuffix, SerialTimingSuffix})
+                {
+                    const SizeType NameSize{ OneTiming.Name.size() - Suffix.size() };
+                    if(OneTiming.Name.size() > Suffix.size() &&
+                       0 == OneTiming.Name.compare(NameSize, Suffix.size(), Suffix))
+                        { GroupTimes[OneTiming.Name.substr(0, NameSize)] = OneTiming.Duration; }
                 }
             }
-            XmlContents << "</testsuite>";
 
-            std::ofstream JunitCompatibleXML("Mezz_Test_Results.xml");
-            JunitCompatibleXML << XmlContents.str() << std::endl;
+            std::ofstream JunitCompatibleXML(FileName, std::ios::out | std::ios::trunc | std::ios::binary);
+            JunitWriter Writer(JunitCompatibleXML);
+            Writer.BeginTestSuites(AllResults.size() + TotalUnstoredSuccesses(UnstoredSuccesses));
+
+            // Each suite counts the successes its group did not store, so the counts of the suites add up to the
+            // count of the whole document. Those are taken out of here as their suites are written.
+            UnstoredSuccessCounts UnwrittenSuccesses{ UnstoredSuccesses };
+            auto WriteSuite = [&](const StringView GroupName,
+                                  UnitTestGroup::TestDataStorageType::const_iterator SuiteBegin,
+                                  const UnitTestGroup::TestDataStorageType::const_iterator SuiteEnd)
+            {
+                Whole TestCount{ static_cast<Whole>(std::distance(SuiteBegin, SuiteEnd)) };
+                const auto FoundUnstored = UnwrittenSuccesses.find(String(GroupName));
+                if(UnwrittenSuccesses.cend() != FoundUnstored)
+                {
+                    TestCount += FoundUnstored->second;
+                    UnwrittenSuccesses.erase(FoundUnstored);
+                }
+                const auto FoundTime = GroupTimes.find(String(GroupName));
+                Writer.BeginTestSuite(GroupName,
+                                      TestCount,
+                                      GroupTimes.cend() == FoundTime ? std::chrono::nanoseconds{0} : FoundTime->second);
+                for(; SuiteBegin != SuiteEnd; ++SuiteBegin)
+                    { Writer.AddTestCase(*SuiteBegin); }
+                Writer.EndTestSuite();
+            };
+
+            // The results of each group are next to each other, so every run of them becomes one test suite.
+            auto SuiteBegin = AllResults.cbegin();
+            while(AllResults.cend() != SuiteBegin)
+            {
+                const StringView GroupName{ JunitWriter::GroupNameOf(SuiteBegin->TestName) };
+                auto SuiteEnd = std::find_if(SuiteBegin, AllResults.cend(), [GroupName](const TestData& OneResult)
+                    { return GroupName != JunitWriter::GroupNameOf(OneResult.TestName); });
+                WriteSuite(GroupName, SuiteBegin, SuiteEnd);
+                SuiteBegin = SuiteEnd;
+            }
+
+            // Groups that stored nothing, because every test passed and successes were only counted.
+            while(!UnwrittenSuccesses.empty())
+            {
+                const String GroupName{ UnwrittenSuccesses.cbegin()->first };
+                WriteSuite(GroupName, AllResults.cend(), AllResults.cend());
+            }
+            Writer.EndTestSuites();
+        }
+
+        void ReportCacheHits(TestReporter& Reporter, const UnitTestGroup::TestDataStorageType& CacheHits)
+        {
+            for(auto OneHit = CacheHits.cbegin(); OneHit != CacheHits.cend(); ++OneHit)
+                { Reporter.ReportResults(OneHit, std::next(OneHit)); }
         }
 
         UnitTestGroup::TestDataStorageType RunTests(const ParsedCommandLineArgs& Options,
-                                                    std::vector<NamedDuration>& TestTimings)
+                                                    std::vector<NamedDuration>& TestTimings,
+                                                    Whole& UnstoredSuccesses)
         {
+            FinishedTestGroups Finished{ Options.CacheHits };
+            if(nullptr != Options.Reporter)
+                { Options.Reporter->BeginRun(); }
+            if(!Options.CacheHits.empty())
+            {
+                for(const TestData& OneHit : Options.CacheHits)
+                    { std::cout << OneHit; }
+                if(nullptr != Options.Reporter)
+                    { ReportCacheHits(*Options.Reporter, Options.CacheHits); }
+            }
+            RunParallelThreads(Options, Finished);
+            RunSerializedTests(Options, Finished);
+
             UnitTestGroup::TestDataStorageType AllResults;
-            RunParallelThreads(Options, AllResults, TestTimings);
-            RunSerializedTests(Options, AllResults, TestTimings);
+            UnstoredSuccessCounts GroupUnstoredSuccesses;
+            Finished.TakeAll(AllResults, TestTimings, GroupUnstoredSuccesses);
+            UnstoredSuccesses = TotalUnstoredSuccesses(GroupUnstoredSuccesses);
+            if(nullptr != Options.Reporter)
+                { Options.Reporter->EndRun(UnstoredSuccesses); }
             if(Options.EmitJunitXml)
-                { EmitJunitResults(AllResults); }
+            {
+                EmitJunitResults(AllResults, ShardFileName(JunitFileName, Options), GroupUnstoredSuccesses,
+                                 TestTimings);
+            }
             return AllResults;
         }
 
@@ -375,29 +1098,172 @@ namespace Mezzanine
                     return EXIT_FAILURE;
                 }
 
-                // Handle the command line arguments.
-                ParsedCommandLineArgs Options = DealWithdCommandLineArgs(argc, argv, TestInstances);
+                // Create only the registered groups that might run, then handle the command line arguments.
+                std::vector<std::unique_ptr<UnitTestGroup>> CreatedGroups;
+                const CoreTestGroup SelectedInstances{
+                    CreateSelectedTestGroups(argc, argv, TestInstances, CreatedGroups) };
+                ParsedCommandLineArgs Options = DealWithdCommandLineArgs(argc, argv, SelectedInstances);
                 if(EXIT_SUCCESS != Options.ExitWithError)
                     { return Options.ExitWithError; }
 
+                // Fork the zygote while this is the only thread and no test has run, so every test group forked from
+                // it starts as fresh as if this executable had been launched again.
+                std::unique_ptr<ProcessZygote> Zygote;
+                if(Options.UseZygote && !Options.InSubProcess && ProcessZygote::IsSupported())
+                {
+                    Zygote = std::make_unique<ProcessZygote>([&SelectedInstances](StringView GroupName)
+                        { return RunForkedTestGroup(SelectedInstances, GroupName); });
+                    Options.Zygote = Zygote.get();
+                }
+
+                // Only after forking the zygote, so groups forked from it still send every result back here.
+                if(Options.FailuresOnly)
+                {
+                    for(UnitTestGroup* OneTestGroup : Options.TestsToRun)
+                        { OneTestGroup->OverrideSuccessDetails(false); }
+                }
+
+                // Sub processes report every result back here, so only the top process decides when to stop.
+                FailFastTrigger CancelTrigger(Options.FailFastSeverity);
+                if(Options.FailFast && !Options.InSubProcess)
+                {
+                    Options.CancelTrigger = &CancelTrigger;
+                    for(UnitTestGroup* OneTestGroup : Options.TestsToRun)
+                        { OneTestGroup->WatchForFailFast(&CancelTrigger); }
+                }
+
+                // Reporters stream results out as groups finish, so only the top process writes them.
+                std::ofstream JsonLinesFile;
+                std::ofstream TapFile;
+                TestReporterList Reporters;
+                if(!Options.SkipFile && !Options.InSubProcess)
+                {
+                    std::unique_ptr<TestResultLog> ResultLog{
+                        std::make_unique<TestResultLog>(ShardFileName(TestResultsFileName, Options)) };
+                    if(ResultLog->IsOpen())
+                        { Reporters.Add(std::move(ResultLog)); }
+                }
+                if(Options.EmitJsonLines && !Options.InSubProcess)
+                {
+                    JsonLinesFile.open(ShardFileName(JsonLinesFileName, Options), std::ios::out | std::ios::trunc);
+                    Reporters.Add(std::make_unique<JsonLinesReporter>(JsonLinesFile));
+                }
+                if(Options.EmitTap && !Options.InSubProcess)
+                {
+                    TapFile.open(ShardFileName(TapFileName, Options), std::ios::out | std::ios::trunc);
+                    Reporters.Add(std::make_unique<TapReporter>(TapFile));
+                }
+                if(!Reporters.Empty())
+                    { Options.Reporter = &Reporters; }
+
                 // Reserve a fairly arbitrary amount of space for storing the timings of the work to be done, make sure
                 // it is a power of two for maximum legitimacy.
                 std::vector<NamedDuration> VariousTimings;
                 VariousTimings.reserve(32);
                 VariousTimings.push_back(TotalTimer.GetNameDuration("Initial Setup"));
 
+                // Start the groups that took longest last time first, so no long group is left to run alone at the
+                // end. Only the top process does this so sub processes do not fight over the file.
+                const Boole UseHistory{ !Options.InSubProcess && !Options.SkipHistory };
+                if(UseHistory || 1 < Options.ShardCount)
+                {
+                    TestTimer HistoryTimer;
+                    TestDurationHistory History;
+                    if(UseHistory)
+                    {
+                        std::ifstream HistoryFile(ShardFileName(TestHistoryFileName, Options));
+                        History = LoadTestHistory(HistoryFile);
+                    }
+
+                    // Every shard must split the groups the same way, but each has its own local history. So only a
+                    // history named on the command line, that every shard reads, splits them by time. Without one
+                    // they are split by the hash of their names.
+                    TestDurationHistory SharedHistory;
+                    if(!Options.ShardHistoryFileName.empty())
+                    {
+                        std::ifstream SharedHistoryFile(Options.ShardHistoryFileName);
+                        if(!SharedHistoryFile)
+                        {
+                            std::cerr << "Could not read the shard history '" << Options.ShardHistoryFileName
+                                      << "', every shard must read the same one." << std::endl;
+                            return EXIT_FAILURE;
+                        }
+                        SharedHistory = LoadTestHistory(SharedHistoryFile);
+                    }
+                    SelectShard(Options.TestsToRun, Options.ShardIndex, Options.ShardCount, SharedHistory);
+                    SortTestsByHistory(Options.TestsToRun, History);
+                    VariousTimings.push_back(HistoryTimer.GetNameDuration("Test Scheduling"));
+                }
+
+                // Groups unchanged since they last passed are not run again, each gets one skipped result instead.
+                const Boole UseIncremental{ Options.Incremental && !Options.InSubProcess };
+                const String IncrementalHistoryFileName{ ShardFileName(IncrementalFileName, Options) };
+                IncrementalHistory Incremental;
+                UInt64 ExecutableHash{0};
+                if(UseIncremental)
+                {
+                    TestTimer IncrementalTimer;
+                    // argv[0] may only be a name found through the PATH, so the running file is asked for instead.
+                    const String ExecutablePath{ GetExecutablePath() };
+                    ExecutableHash = ExecutablePath.empty() ? 0 : HashFileContents(ExecutablePath);
+                    if(0 == ExecutableHash)
+                    {
+                        std::cerr << "Could not read the test executable '" << ExecutablePath
+                                  << "', incremental runs are disabled and every test group will run." << std::endl;
+                    }
+                    std::ifstream HistoryFile(IncrementalHistoryFileName);
+                    Incremental = LoadIncrementalHistory(HistoryFile);
+                    Options.CacheHits = SkipUnchangedTests(Options.TestsToRun, Incremental, ExecutableHash);
+                    VariousTimings.push_back(IncrementalTimer.GetNameDuration("Incremental Check"));
+                }
+
                 // Run the tests that need to be run.
                 TestTimer TestExecutionTimer;
-                UnitTestGroup::TestDataStorageType AllResults = RunTests(Options, VariousTimings);
+                Whole UnstoredSuccesses{0};
+                UnitTestGroup::TestDataStorageType AllResults = RunTests(Options, VariousTimings, UnstoredSuccesses);
                 VariousTimings.emplace_back(TestExecutionTimer.GetNameDuration("Test Execution Time"));
 
+                // Like the history below, the new records are written beside the old file and swapped in.
+                if(UseIncremental && 0 != ExecutableHash)
+                {
+                    UpdateIncrementalHistory(Incremental, Options.TestsToRun, AllResults, ExecutableHash);
+                    const String TemporaryFileName{ IncrementalHistoryFileName + ".new" };
+                    {
+                        std::ofstream HistoryFile(TemporaryFileName, std::ios::out | std::ios::trunc);
+                        SaveIncrementalHistory(Incremental, HistoryFile);
+                    }
+                    std::remove(IncrementalHistoryFileName.c_str());
+                    std::rename(TemporaryFileName.c_str(), IncrementalHistoryFileName.c_str());
+                }
+
+                // Write the new history beside the file and swap it in, so an interrupted run cannot leave half a file.
+                // It is read again first to keep durations from runs that finished meanwhile. Shards only write their
+                // own file, those files can simply be concatenated into one to give every shard with ShardHistoryToken.
+                if(UseHistory)
+                {
+                    const String HistoryFileName{ ShardFileName(TestHistoryFileName, Options) };
+                    TestDurationHistory History;
+                    {
+                        std::ifstream HistoryFile(HistoryFileName);
+                        History = LoadTestHistory(HistoryFile);
+                    }
+                    UpdateTestHistory(History, VariousTimings);
+                    const String TemporaryHistoryFileName{ HistoryFileName + ".new" };
+                    {
+                        std::ofstream HistoryFile(TemporaryHistoryFileName, std::ios::out | std::ios::trunc);
+                        SaveTestHistory(History, HistoryFile);
+                    }
+                    std::remove(HistoryFileName.c_str());
+                    std::rename(TemporaryHistoryFileName.c_str(), HistoryFileName.c_str());
+                }
+
                 TestResult Worst;
                 if(!Options.SkipSummary)
                 {
                     // Handle formatting test results.
                     TestTimer SummaryTimer;
                     std::stringstream SummaryStream;
-                    Worst = RenderTestResultSummary(AllResults, SummaryStream);
+                    Worst = RenderTestResultSummary(AllResults, SummaryStream, UnstoredSuccesses);
                     VariousTimings.push_back(SummaryTimer.GetNameDuration("Summary Reporting Time"));
 
                     // Handle Formatting Times.
@@ -55,7 +55,14 @@ SUPPRESS_VC_WARNING(4668) // _WIN32_WINNT_WIN10_RS5 isn't defined causing a warn
     #include "windows.h"
 #else // MEZZ_Windows
     #include "unistd.h"
+    #ifdef __APPLE__
+        #include <mach-o/dyld.h>
+    #endif // __APPLE__
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
     #include <string.h>
+    #include <sys/socket.h>
     #include <sys/types.h>
     #include <sys/wait.h>
 #endif // MEZZ_Windows
@@ -70,15 +77,134 @@ RESTORE_WARNING_STATE
 #undef min
 #endif // max
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
 #include <exception>
+#include <cstdio>
 #include <cstdlib>
 
 #include <iostream>
 #include <fstream>
 #include <limits>
+#include <thread>
 
 namespace {
     using namespace Mezzanine;
+
+    /// @brief The clock deadlines for launched processes are kept on, it never jumps when the system time is set.
+    using DeadlineClock = std::chrono::steady_clock;
+
+    /// @brief Work out when something that may only run for a while has to stop.
+    /// @param Timeout How long it may run, zero or less means it may run forever.
+    /// @return The time it must stop by, the largest time point if it never has to.
+    [[nodiscard]]
+    DeadlineClock::time_point DeadlineAfter(const std::chrono::nanoseconds Timeout)
+    {
+        const DeadlineClock::time_point Now{ DeadlineClock::now() };
+        if( Timeout <= std::chrono::nanoseconds::zero() ||
+            Timeout >= DeadlineClock::time_point::max() - Now ) {
+            return DeadlineClock::time_point::max();
+        }
+        return Now + std::chrono::duration_cast<DeadlineClock::duration>(Timeout);
+    }
+
+    /// @brief How many milliseconds are left until a deadline, rounded up so waiting that long reaches it.
+    /// @param Deadline The time to count down to, the largest time point means there is none.
+    /// @param Forever What to return when there is no deadline.
+    /// @return The milliseconds left, 0 once the deadline has passed.
+    template<typename MillisecondType>
+    [[nodiscard]]
+    MillisecondType MillisecondsUntil(const DeadlineClock::time_point Deadline, const MillisecondType Forever)
+    {
+        if( Deadline == DeadlineClock::time_point::max() ) {
+            return Forever;
+        }
+        const std::chrono::milliseconds::rep Left{
+            std::chrono::ceil<std::chrono::milliseconds>(Deadline - DeadlineClock::now()).count() };
+        if( Left <= 0 ) {
+            return 0;
+        }
+        return static_cast<MillisecondType>(
+            std::min<std::chrono::milliseconds::rep>(Left, std::numeric_limits<MillisecondType>::max() - 1) );
+    }
+
+    /// @brief Why a launched process was stopped before it finished, if it was.
+    enum class StopReason
+    {
+        None,       ///< It was not stopped.
+        TimedOut,   ///< It ran past its deadline.
+        Cancelled   ///< Its cancel flag was set.
+    };
+
+    /// @brief How often a cancel flag is looked at while waiting on a process, in milliseconds.
+    constexpr int CancelCheckMilliseconds = 50;
+
+    /// @brief What can stop a launched process before it finishes.
+    struct StopCondition
+    {
+        /// @brief When the process has to stop by, the largest time point if it never has to.
+        DeadlineClock::time_point Deadline;
+        /// @brief If set the process has to stop once this is true.
+        const std::atomic<Boole>* Cancel;
+
+        /// @return True if there is a deadline or a cancel flag.
+        [[nodiscard]]
+        Boole CanStop() const
+            { return Deadline != DeadlineClock::time_point::max() || Cancel != nullptr; }
+
+        /// @return Why the process has to be stopped now or StopReason::None if it can keep going.
+        [[nodiscard]]
+        StopReason Check() const
+        {
+            if( Cancel != nullptr && Cancel->load() ) {
+                return StopReason::Cancelled;
+            }
+            if( Deadline != DeadlineClock::time_point::max() && Deadline <= DeadlineClock::now() ) {
+                return StopReason::TimedOut;
+            }
+            return StopReason::None;
+        }
+
+        /// @brief How long to wait for the process before calling Check again.
+        /// @param Forever What to return when nothing can stop the process.
+        /// @return The milliseconds to wait, a cancel flag is looked at every CancelCheckMilliseconds.
+        template<typename MillisecondType>
+        [[nodiscard]]
+        MillisecondType WaitMilliseconds(const MillisecondType Forever) const
+        {
+            const MillisecondType UntilDeadline{ MillisecondsUntil(Deadline,Forever) };
+            if( Cancel == nullptr ) {
+                return UntilDeadline;
+            }
+            const MillisecondType CancelCheck{ static_cast<MillisecondType>(CancelCheckMilliseconds) };
+            return UntilDeadline == Forever ? CancelCheck : std::min(UntilDeadline,CancelCheck);
+        }
+    };
+
+    /// @brief Gather what can stop a process that is about to be launched.
+    /// @param Timeout How long it may run, zero or less means it may run forever.
+    /// @param Cancel If set the process has to stop once this is true.
+    /// @return The conditions to pass along to whatever waits on the process.
+    [[nodiscard]]
+    StopCondition StopAfter(const std::chrono::nanoseconds Timeout, const std::atomic<Boole>* Cancel)
+        { return { DeadlineAfter(Timeout), Cancel }; }
+
+    /// @brief The exit code to report for a process that was stopped.
+    /// @param Reason Why it was stopped.
+    /// @param ExitCode What to report if it was not stopped.
+    /// @return TimedOutExitCode, CancelledExitCode or ExitCode.
+    [[nodiscard]]
+    Integer StoppedExitCode(const StopReason Reason, const Integer ExitCode)
+    {
+        switch( Reason ) {
+            case StopReason::TimedOut:  return Testing::TimedOutExitCode;
+            case StopReason::Cancelled: return Testing::CancelledExitCode;
+            case StopReason::None:      break;
+        }
+        return ExitCode;
+    }
 #ifdef MEZZ_Windows
     /// @brief A struct with basic info that can be returned from attempting to launch a process.
     struct MEZZ_LIB ProcessInfo
@@ -223,6 +349,7 @@ namespace {
     struct MEZZ_LIB ProcessInfo
     {
         int ChildPipe = 0;
+        int ResultPipe = -1;
         int ChildPID = 0;
     };//ProcessInfo
 
@@ -245,28 +372,221 @@ namespace {
         return String{ ExtractFrom.substr(0,SplitPos) };
     }
 
+    /// @brief Convert a status from waitpid into the exit code RunCommand reports.
+    /// @param Status The status as filled in by waitpid.
+    /// @return The exit code if the process exited or the signal number if it was killed.
+    [[nodiscard]]
+    Integer ExitCodeFromStatus(const int Status)
+    {
+        if( WIFEXITED(Status) ) {
+            return WEXITSTATUS(Status);
+        }else if( WIFSIGNALED(Status) ) {
+            return WTERMSIG(Status);
+        }
+        // No idea what else could have happened
+        return Status;
+    }
+
+    /// @brief Create a pipe that will not leak into other programs that might be launched.
+    /// @details Where possible the pipe is created close on exec, so a worker thread that forks and execs at the same
+    /// moment cannot inherit it. Only platforms without pipe2() set the flag afterwards.
+    /// @param Pipes The two file descriptors, read end first, just like pipe().
+    void CreateCloseOnExecPipe(int (&Pipes)[2])
+    {
+    #ifdef __APPLE__
+        if( ::pipe(Pipes) < 0 ) {
+            throw std::runtime_error("Unable to create pipe for child process.");
+        }
+        ::fcntl(Pipes[0],F_SETFD,FD_CLOEXEC);
+        ::fcntl(Pipes[1],F_SETFD,FD_CLOEXEC);
+    #else
+        if( ::pipe2(Pipes,O_CLOEXEC) < 0 ) {
+            throw std::runtime_error("Unable to create pipe for child process.");
+        }
+    #endif
+    }
+
+    /// @brief Create a connected pair of local sockets that will not leak into other programs that might be launched.
+    /// @param Sockets The two connected sockets, just like socketpair().
+    void CreateCloseOnExecSocketPair(int (&Sockets)[2])
+    {
+    #ifdef SOCK_CLOEXEC
+        if( ::socketpair(AF_UNIX,SOCK_STREAM | SOCK_CLOEXEC,0,Sockets) < 0 ) {
+            throw std::runtime_error("Unable to create control socket for process zygote.");
+        }
+    #else
+        if( ::socketpair(AF_UNIX,SOCK_STREAM,0,Sockets) < 0 ) {
+            throw std::runtime_error("Unable to create control socket for process zygote.");
+        }
+        ::fcntl(Sockets[0],F_SETFD,FD_CLOEXEC);
+        ::fcntl(Sockets[1],F_SETFD,FD_CLOEXEC);
+    #endif
+    }
+
+    /// @brief Write all of a buffer to a file descriptor, retrying short writes.
+    /// @param Destination The file descriptor to write to.
+    /// @param Buffer The start of the data to write.
+    /// @param Length How many bytes to write.
+    /// @return True if everything was written.
+    Boole WriteAll(const int Destination, const void* Buffer, size_t Length)
+    {
+        const char* Remaining = static_cast<const char*>(Buffer);
+        while( Length > 0 )
+        {
+            const ssize_t Written = ::write(Destination,Remaining,Length);
+            if( Written < 0 ) {
+                if( errno == EINTR ) {
+                    continue;
+                }
+                return false;
+            }
+            Remaining += Written;
+            Length -= static_cast<size_t>(Written);
+        }
+        return true;
+    }
+
+    /// @brief Read exactly a given number of bytes from a file descriptor.
+    /// @param Source The file descriptor to read from.
+    /// @param Buffer Where to put what was read.
+    /// @param Length How many bytes to read.
+    /// @return True if every byte was read before the other end closed.
+    Boole ReadAll(const int Source, void* Buffer, size_t Length)
+    {
+        char* Remaining = static_cast<char*>(Buffer);
+        while( Length > 0 )
+        {
+            const ssize_t BytesRead = ::read(Source,Remaining,Length);
+            if( BytesRead < 0 && errno == EINTR ) {
+                continue;
+            }
+            if( BytesRead <= 0 ) {
+                return false;
+            }
+            Remaining += BytesRead;
+            Length -= static_cast<size_t>(BytesRead);
+        }
+        return true;
+    }
+
+    /// @brief Put a file descriptor at a specific number in a freshly forked child, so it survives exec.
+    /// @param From The descriptor to move, it is closed unless it is already in place.
+    /// @param To The number the descriptor should have.
+    void MoveDescriptorTo(const int From, const int To)
+    {
+        if( From == To ) {
+            ::fcntl(To,F_SETFD,0); // Already in place, it just needs to stay open across exec.
+            return;
+        }
+        ::dup2( From, To );
+        ::close( From );
+    }
+
+    /// @brief Read a process's console output and result channel until both are closed or it has to stop.
+    /// @details Both are read as data arrives so a process filling one pipe never blocks while this waits on the
+    /// other. Both descriptors are closed when this returns.
+    /// @param OutputPipe The read end of the console output pipe.
+    /// @param ResultPipe The read end of the result channel pipe or -1 if there is none.
+    /// @param OnConsoleOutput Passed each chunk of console output as it arrives, if set.
+    /// @param OnResultChannel Passed each chunk from the result channel as it arrives, if set.
+    /// @param Stop When to stop reading even if the pipes are still open.
+    /// @return Why reading stopped before both pipes were closed, or StopReason::None if they were.
+    StopReason ReadProcessPipes(const int OutputPipe,
+                                const int ResultPipe,
+                                const Testing::CommandOutputCallback& OnConsoleOutput,
+                                const Testing::CommandOutputCallback& OnResultChannel,
+                                const StopCondition& Stop)
+    {
+        pollfd Watched[2] = { { OutputPipe, POLLIN, 0 }, { ResultPipe, POLLIN, 0 } };
+        const Testing::CommandOutputCallback* Destinations[2] = { &OnConsoleOutput, &OnResultChannel };
+        char PipeBuf[4096];
+        StopReason Stopped = StopReason::None;
+
+        // Poll skips negative descriptors, so each one is marked done by negating it.
+        while( Watched[0].fd >= 0 || Watched[1].fd >= 0 )
+        {
+            Stopped = Stop.Check();
+            if( Stopped != StopReason::None ) {
+                break;
+            }
+            if( ::poll(Watched,2,Stop.WaitMilliseconds(-1)) < 0 ) {
+                if( errno == EINTR ) {
+                    continue;
+                }
+                break;
+            }
+            for( size_t Idx = 0 ; Idx < 2 ; ++Idx )
+            {
+                if( Watched[Idx].fd < 0 || Watched[Idx].revents == 0 ) {
+                    continue;
+                }
+                const ssize_t BytesRead = ::read(Watched[Idx].fd,PipeBuf,sizeof(PipeBuf));
+                if( BytesRead > 0 ) {
+                    if( *Destinations[Idx] ) {
+                        (*Destinations[Idx])(StringView(PipeBuf,static_cast<size_t>(BytesRead)));
+                    }
+                }else if( BytesRead == 0 || errno != EINTR ) {
+                    ::close(Watched[Idx].fd);
+                    Watched[Idx].fd = -1;
+                }
+            }
+        }
+        for( const pollfd& OneWatched : Watched )
+        {
+            if( OneWatched.fd >= 0 ) {
+                ::close(OneWatched.fd);
+            }
+        }
+        return Stopped;
+    }
+
+    /// @brief Wait for a child process to end, even if a signal interrupts the wait.
+    /// @param ChildID The process to wait for.
+    /// @return The status as filled in by waitpid.
+    int WaitForChild(const pid_t ChildID)
+    {
+        int Status = -1;
+        while( ::waitpid(ChildID,&Status,0) < 0 && errno == EINTR )
+            {}
+        return Status;
+    }
+
     /// @brief Creates and launches a new process.
     /// @remarks The path to the executable to be launched must appear in both parameters to this function.
     /// @param ExePathName Specifies the exe that will be launched. MUST contain the path to the executable
     /// being launched.
     /// @param Arguments The space separated arguments given to the exe being launched. This MUST include
     /// the path the executable as the first argument.
+    /// @param WithResultChannel If true the child also gets a pipe at Testing::ResultChannelDescriptor.
     /// @return Returns a ProcessInfo struct containing information about the launched process.
     [[nodiscard]]
-    ProcessInfo CreateCommandProcess(StringView ExePathName, const StringView Arguments)
+    ProcessInfo CreateCommandProcess(StringView ExePathName,
+                                     const StringView Arguments,
+                                     const Boole WithResultChannel = false)
     {
         int Pipes[2];
-        if( ::pipe(Pipes) < 0 ) {
-            throw std::runtime_error("Unable to create pipe for child process.");
+        int ResultPipes[2] = { -1, -1 };
+        CreateCloseOnExecPipe(Pipes);
+        if( WithResultChannel ) {
+            try {
+                CreateCloseOnExecPipe(ResultPipes);
+            } catch (...) {
+                ::close(Pipes[0]);
+                ::close(Pipes[1]);
+                throw;
+            }
         }
 
         std::cout.flush(); // Clean out the pipes before they may be important.
         pid_t ProcessID = ::fork();
         if( ProcessID == 0 ) { // Child
             ::close( Pipes[0] ); // Close Read end of pipe.
-            ::dup2( Pipes[1], 1 ); // Direct cout file descriptor to our pipe.
+            MoveDescriptorTo( Pipes[1], 1 ); // Direct cout file descriptor to our pipe.
             //::dup2( Pipes[1], 2 ); // Direct cerr file descriptor to our pipe.
-            ::close( Pipes[1] ); // Done mangling pipes.
+            if( WithResultChannel ) {
+                ::close( ResultPipes[0] );
+                MoveDescriptorTo( ResultPipes[1], Testing::ResultChannelDescriptor );
+            }
 
             std::vector<Mezzanine::String> ArgVector;
             String TempStr;
@@ -301,27 +621,205 @@ namespace {
             return { 0, 0 };
         }else if( ProcessID > 0 ) { // Parent
             ::close( Pipes[1] ); // Close Write end of pipe
-            return { Pipes[0], ProcessID };
+            if( WithResultChannel ) {
+                ::close( ResultPipes[1] );
+            }
+            return { Pipes[0], ResultPipes[0], ProcessID };
         }else{
+            ::close( Pipes[0] );
+            ::close( Pipes[1] );
+            if( WithResultChannel ) {
+                ::close( ResultPipes[0] );
+                ::close( ResultPipes[1] );
+            }
             throw std::runtime_error("Unable to create forked process.");
         }
     }
+
+    /// @brief How many file descriptors go with each request to the zygote, the output, result and status pipes.
+    constexpr size_t ZygoteRequestFDCount = 3;
+
+    /// @brief Send a request to run a job to the zygote, along with the pipes the job should report on.
+    /// @param ControlSocket The parent end of the control socket.
+    /// @param JobName The name of the job to run.
+    /// @param FDs The write ends of the output, result and status pipes.
+    /// @return True if the request was sent.
+    Boole SendZygoteRequest(const int ControlSocket, const StringView JobName, const int (&FDs)[ZygoteRequestFDCount])
+    {
+        UInt32 NameLength = static_cast<UInt32>(JobName.size());
+        iovec Header{ &NameLength, sizeof(NameLength) };
+
+        alignas(cmsghdr) char Control[CMSG_SPACE(sizeof(FDs))] = {};
+        msghdr Message{};
+        Message.msg_iov = &Header;
+        Message.msg_iovlen = 1;
+        Message.msg_control = Control;
+        Message.msg_controllen = sizeof(Control);
+
+        cmsghdr* FDMessage = CMSG_FIRSTHDR(&Message);
+        FDMessage->cmsg_level = SOL_SOCKET;
+        FDMessage->cmsg_type = SCM_RIGHTS;
+        FDMessage->cmsg_len = CMSG_LEN(sizeof(FDs));
+        ::memcpy(CMSG_DATA(FDMessage),FDs,sizeof(FDs));
+
+    #ifdef MSG_NOSIGNAL
+        const int SendFlags = MSG_NOSIGNAL; // A dead zygote should be an error, not a SIGPIPE.
+    #else
+        const int SendFlags = 0;
+    #endif
+        ssize_t Sent = -1;
+        do {
+            Sent = ::sendmsg(ControlSocket,&Message,SendFlags);
+        } while( Sent < 0 && errno == EINTR );
+        if( Sent != static_cast<ssize_t>(sizeof(NameLength)) ) {
+            return false;
+        }
+        return WriteAll(ControlSocket,JobName.data(),JobName.size());
+    }
+
+    /// @brief Wait for the next request sent with SendZygoteRequest.
+    /// @param ControlSocket The zygote end of the control socket.
+    /// @param JobName Filled with the name of the job to run.
+    /// @param FDs Filled with the write ends of the output, result and status pipes.
+    /// @return False if the parent closed the socket or something went wrong, the zygote should quit then.
+    Boole ReceiveZygoteRequest(const int ControlSocket, String& JobName, int (&FDs)[ZygoteRequestFDCount])
+    {
+        UInt32 NameLength = 0;
+        iovec Header{ &NameLength, sizeof(NameLength) };
+
+        alignas(cmsghdr) char Control[CMSG_SPACE(sizeof(FDs))] = {};
+        msghdr Message{};
+        Message.msg_iov = &Header;
+        Message.msg_iovlen = 1;
+        Message.msg_control = Control;
+        Message.msg_controllen = sizeof(Control);
+
+        ssize_t Received = -1;
+        do {
+            Received = ::recvmsg(ControlSocket,&Message,0);
+        } while( Received < 0 && errno == EINTR );
+        if( Received != static_cast<ssize_t>(sizeof(NameLength)) ) {
+            return false;
+        }
+
+        cmsghdr* FDMessage = CMSG_FIRSTHDR(&Message);
+        if( FDMessage == nullptr || FDMessage->cmsg_type != SCM_RIGHTS ||
+            FDMessage->cmsg_len != CMSG_LEN(sizeof(FDs)) )
+            { return false; }
+        ::memcpy(FDs,CMSG_DATA(FDMessage),sizeof(FDs));
+
+        JobName.assign(NameLength,'\0');
+        return ReadAll(ControlSocket,&JobName[0],NameLength);
+    }
+
+    /// @brief Run a single job in a grandchild of the zygote and report how it ended.
+    /// @details The zygote ignores SIGCHLD so its children are reaped automatically, but that means it cannot
+    /// wait on them. So each job is run by a short lived watcher, which can wait on the job and report its status.
+    /// The watcher sends the ID of the job first, so the parent can kill it if it runs too long.
+    /// @param Entry The work to do.
+    /// @param JobName The name of the job passed to the entry.
+    /// @param FDs The write ends of the output, result and status pipes.
+    [[noreturn]]
+    void RunZygoteJob(const Testing::ForkedProcessEntry& Entry,
+                      const StringView JobName,
+                      const int (&FDs)[ZygoteRequestFDCount])
+    {
+        ::signal(SIGCHLD,SIG_DFL);
+        const pid_t JobID = ::fork();
+        if( JobID == 0 ) { // The Job
+            ::close( FDs[2] );
+            MoveDescriptorTo( FDs[0], 1 ); // Direct cout file descriptor to the output pipe.
+            MoveDescriptorTo( FDs[1], Testing::ResultChannelDescriptor );
+
+            Integer JobExitCode = EXIT_FAILURE;
+            try {
+                JobExitCode = Entry(JobName);
+            } catch (const std::exception& e) {
+                std::cout << "Uncaught exception of type std::exception in forked process. it says:\n"
+                          << e.what() << std::endl;
+            } catch (...) {
+                std::cout << "Uncaught exception of unknown type in forked process." << std::endl;
+            }
+            std::cout.flush();
+            std::fflush(stdout);
+            ::_exit(JobExitCode);
+        }
+
+        // The watcher
+        ::close( FDs[0] );
+        ::close( FDs[1] );
+        WriteAll(FDs[2],&JobID,sizeof(JobID));
+        int Status = -1;
+        if( JobID > 0 ) {
+            Status = WaitForChild(JobID);
+        }
+        WriteAll(FDs[2],&Status,sizeof(Status));
+        ::_exit(EXIT_SUCCESS);
+    }
+
+    /// @brief The loop the zygote process runs until the parent closes the control socket.
+    /// @param ControlSocket The zygote end of the control socket.
+    /// @param Entry The work to do for each request.
+    [[noreturn]]
+    void RunZygote(const int ControlSocket, const Testing::ForkedProcessEntry& Entry)
+    {
+        ::signal(SIGCHLD,SIG_IGN);
+        String JobName;
+        int FDs[ZygoteRequestFDCount] = { -1, -1, -1 };
+        while( ReceiveZygoteRequest(ControlSocket,JobName,FDs) )
+        {
+            if( ::fork() == 0 ) {
+                ::close( ControlSocket );
+                RunZygoteJob(Entry,JobName,FDs);
+            }
+            // If the fork failed, closing these will report the failure to the parent.
+            for( const int OneFD : FDs )
+                { ::close( OneFD ); }
+        }
+        ::_exit(EXIT_SUCCESS);
+    }
 #endif // MEZZ_Windows
 
-    /// @brief Launches a new process with the given command and collects it's output.
+    /// @brief Launches a new process with the given command and passes along its output as it arrives.
     /// @param ExePathName The absolute path, relative path, or file name in the system path to be executed.
     /// @param Command The arguments given to the launched executable.
-    /// @return Returns a command result, containing the exit code and console output of the launched executable.
+    /// @param OnConsoleOutput Passed each chunk of console output from the launched executable.
+    /// @param OnResultChannel If set the launched executable also gets a result channel, where supported, and this is
+    /// passed each chunk written to it.
+    /// @param Stop When to kill the launched executable if it is still running.
+    /// @return Returns the exit code of the launched executable, or TimedOutExitCode or CancelledExitCode if it was
+    /// killed.
     [[nodiscard]]
-    Testing::CommandResult RunCommandImpl(const StringView ExePathName, const StringView Command)
+    Integer RunCommandImpl(const StringView ExePathName,
+                           const StringView Command,
+                           const Testing::CommandOutputCallback& OnConsoleOutput,
+                           const Testing::CommandOutputCallback& OnResultChannel,
+                           const StopCondition& Stop)
     {
-        Testing::CommandResult Result;
 #ifdef MEZZ_Windows
+        (void)OnResultChannel; // Windows processes only get console output.
         ProcessInfo ChildInfo = CreateCommandProcess( ExePathName, Command );
         if( ChildInfo.ErrorNum != 0 ) {
-            Result.ExitCode = 1;
-            Result.ConsoleOutput = ChildInfo.ErrorStr;
-            return Result;
+            OnConsoleOutput(ChildInfo.ErrorStr);
+            return 1;
+        }
+
+        // ReadFile blocks until the child writes or exits, so the child is ended from another thread if need be.
+        std::atomic<StopReason> Stopped{StopReason::None};
+        std::thread Watcher;
+        if( Stop.CanStop() ) {
+            Watcher = std::thread([&ChildInfo,&Stopped,&Stop]() {
+                while( ::WaitForSingleObject(ChildInfo.ChildProcess,Stop.WaitMilliseconds<DWORD>(INFINITE)) ==
+                       WAIT_TIMEOUT )
+                {
+                    const StopReason Reason{ Stop.Check() };
+                    if( Reason != StopReason::None ) {
+                        Stopped = Reason;
+                        ::TerminateProcess(ChildInfo.ChildProcess,EXIT_FAILURE);
+                        break;
+                    }
+                }
+            });
         }
 
         DWORD BytesRead = 0;
@@ -331,41 +829,71 @@ namespace {
             if( BytesRead == 0 ) {
                 break;
             }
-            Result.ConsoleOutput.append(PipeBuf,BytesRead);
+            OnConsoleOutput(StringView(PipeBuf,BytesRead));
         }
         ::CloseHandle(ChildInfo.ChildPipe);
+        if( Watcher.joinable() ) {
+            Watcher.join();
+        }
 
         DWORD ExitStatus;
         ::GetExitCodeProcess(ChildInfo.ChildProcess,&ExitStatus);
-        Result.ExitCode = ExitStatus;
         ::CloseHandle(ChildInfo.ChildProcess);
+        return StoppedExitCode(Stopped,static_cast<Integer>(ExitStatus));
 #else // Mezz_Windows
         String NonConstExecPath{ ExePathName };
-        ProcessInfo ChildInfo = CreateCommandProcess( NonConstExecPath, Command );
+        ProcessInfo ChildInfo = CreateCommandProcess( NonConstExecPath, Command, static_cast<Boole>(OnResultChannel) );
 
-        ssize_t BytesRead = -1;
-        char PipeBuf[1024];
-        // Start reading and keep on reading until we hit an error or EoF.
-        while( ( BytesRead = ::read(ChildInfo.ChildPipe,PipeBuf,sizeof(PipeBuf)) ) > 0 )
-            { Result.ConsoleOutput.append(PipeBuf,static_cast<size_t>(BytesRead)); }
-        ::close(ChildInfo.ChildPipe);
-
-        int Status = -1;
-        ::waitpid(ChildInfo.ChildPID,&Status,0);
-        if( WIFEXITED(Status) ) {
-            Result.ExitCode = WEXITSTATUS(Status);
-        }else if( WIFSIGNALED(Status) ) {
-            Result.ExitCode = WTERMSIG(Status);
-        }else{
-            // No idea what else could have happened
-            Result.ExitCode = Status;
+        const StopReason Stopped{
+            ReadProcessPipes(ChildInfo.ChildPipe,ChildInfo.ResultPipe,OnConsoleOutput,OnResultChannel,Stop) };
+        if( Stopped != StopReason::None ) {
+            ::kill(ChildInfo.ChildPID,SIGKILL);
         }
+        return StoppedExitCode( Stopped, ExitCodeFromStatus(WaitForChild(ChildInfo.ChildPID)) );
 #endif // MEZZ_Windows
+    }
+
+    /// @brief Gather all the output of something that streams it, the way RunCommand always has.
+    /// @param Runner Called with the callbacks to stream to, it returns the exit code.
+    /// @param WithResultChannel Should the result channel be collected too.
+    /// @return Returns the exit code and all the output, with trailing newlines trimmed from the console output.
+    template<typename RunnerType>
+    [[nodiscard]]
+    Testing::CommandResult CollectCommandResult(const RunnerType& Runner, const Boole WithResultChannel)
+    {
+        Testing::CommandResult Result;
+        const Testing::CommandOutputCallback OnConsoleOutput = [&Result](StringView Chunk)
+            { Result.ConsoleOutput.append(Chunk.data(),Chunk.size()); };
+        Testing::CommandOutputCallback OnResultChannel;
+        if( WithResultChannel ) {
+            OnResultChannel = [&Result](StringView Chunk)
+                { Result.ResultChannelOutput.append(Chunk.data(),Chunk.size()); };
+        }
+        Result.ExitCode = Runner(OnConsoleOutput,OnResultChannel);
+
         // Trim newlines
         while( CanTrimBack(Result.ConsoleOutput) )
             { Result.ConsoleOutput.pop_back(); }
         return Result;
     }
+
+    /// @brief Make sure a command will run as written and split out the executable.
+    /// @param Command The whole command that will be run.
+    /// @return The path of the executable to run, empty on Windows where it is not needed.
+    [[nodiscard]]
+    String CheckCommand(const StringView Command)
+    {
+        const Mezzanine::String SafeCommand( Testing::SanitizeProcessCommand(Command) );
+        if( SafeCommand != Command )
+            { throw std::runtime_error("Command included unsafe characters, it would not run correctly."); }
+#ifdef MEZZ_Windows
+        // Windows is happy to parse just a single string for everything.
+        return String();
+#else // Mezz_Windows
+        // Posix is NOT happy to do the same.  The strings must be separate.
+        return Testing::SanitizeProcessCommand(ExtractExecPath(Command));
+#endif // MEZZ_Windows
+    }
 }
 
 namespace Mezzanine {
@@ -379,7 +907,10 @@ namespace Testing {
         const Mezzanine::String SafeCommand( SanitizeProcessCommand(Command) );
         if( SafeCommand != Command )
             { throw std::runtime_error("Command included unsafe characters, it would not run correctly."); }
-        return RunCommandImpl(SafePathName,SafeCommand);
+        return CollectCommandResult([&](const CommandOutputCallback& OnConsoleOutput,
+                                        const CommandOutputCallback& OnResultChannel)
+            { return RunCommandImpl(SafePathName,SafeCommand,OnConsoleOutput,OnResultChannel,
+                                    StopAfter(std::chrono::nanoseconds::zero(),nullptr)); }, false);
     }
 
     CommandResult RunCommand(const StringView Command)
@@ -394,5 +925,210 @@ namespace Testing {
         return RunCommand(ExecPath,Command);
 #endif // MEZZ_Windows
     }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Result Channel
+
+    Boole ResultChannelIsSupported()
+    {
+#ifdef MEZZ_Windows
+        return false;
+#else // Mezz_Windows
+        return true;
+#endif // MEZZ_Windows
+    }
+
+    CommandResult RunCommandWithResultChannel(const StringView Command)
+    {
+        return CollectCommandResult([Command](const CommandOutputCallback& OnConsoleOutput,
+                                              const CommandOutputCallback& OnResultChannel)
+            { return RunCommandStreaming(Command,OnConsoleOutput,OnResultChannel); }, true);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Output to Callbacks
+
+    Integer RunCommandStreaming(const StringView Command,
+                                const CommandOutputCallback& OnConsoleOutput,
+                                const CommandOutputCallback& OnResultChannel,
+                                const std::chrono::nanoseconds Timeout,
+                                const std::atomic<Boole>* Cancel)
+    {
+        const Mezzanine::String ExecPath{ CheckCommand(Command) };
+        return RunCommandImpl(ExecPath,Command,OnConsoleOutput,OnResultChannel,StopAfter(Timeout,Cancel));
+    }
+
+    Boole WriteToResultChannel(const StringView Data)
+    {
+#ifdef MEZZ_Windows
+        (void)Data;
+        return false;
+#else // Mezz_Windows
+        return WriteAll(ResultChannelDescriptor,Data.data(),Data.size());
+#endif // MEZZ_Windows
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Executable Location
+
+    Mezzanine::String GetExecutablePath()
+    {
+#ifdef MEZZ_Windows
+        // The path is cut short without an error when the buffer is too small, so grow it until it fits.
+        Mezzanine::String Path(MAX_PATH, '\0');
+        while( true )
+        {
+            const DWORD Length = ::GetModuleFileNameA(NULL,&Path[0],static_cast<DWORD>(Path.size()));
+            if( Length == 0 ) {
+                return Mezzanine::String();
+            }
+            if( Length < Path.size() ) {
+                Path.resize(Length);
+                return Path;
+            }
+            Path.resize(Path.size() * 2);
+        }
+#elif defined(__APPLE__)
+        uint32_t Size = 0;
+        ::_NSGetExecutablePath(nullptr,&Size);
+        Mezzanine::String Path(Size, '\0');
+        if( ::_NSGetExecutablePath(&Path[0],&Size) != 0 ) {
+            return Mezzanine::String();
+        }
+        Path.resize(::strlen(Path.c_str()));
+        return Path;
+#else // MEZZ_Windows
+        // readlink does not say if it ran out of room, so a result that fills the buffer is retried with more.
+        Mezzanine::String Path(256, '\0');
+        while( true )
+        {
+            const ssize_t Length = ::readlink("/proc/self/exe",&Path[0],Path.size());
+            if( Length < 0 ) {
+                return Mezzanine::String();
+            }
+            if( static_cast<size_t>(Length) < Path.size() ) {
+                Path.resize(static_cast<size_t>(Length));
+                return Path;
+            }
+            Path.resize(Path.size() * 2);
+        }
+#endif // MEZZ_Windows
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // ProcessZygote
+
+#ifdef MEZZ_Windows
+    ProcessZygote::ProcessZygote(const ForkedProcessEntry&)
+        { throw std::runtime_error("Process zygotes require fork(), which Windows does not have."); }
+
+    ProcessZygote::~ProcessZygote() = default;
+
+    Boole ProcessZygote::IsSupported()
+        { return false; }
+
+    Integer ProcessZygote::RunInChildStreaming(const StringView,
+                                               const CommandOutputCallback&,
+                                               const CommandOutputCallback&,
+                                               const std::chrono::nanoseconds,
+                                               const std::atomic<Boole>*)
+        { throw std::runtime_error("Process zygotes require fork(), which Windows does not have."); }
+#else // MEZZ_Windows
+    ProcessZygote::ProcessZygote(const ForkedProcessEntry& Entry)
+    {
+        int Sockets[2];
+        CreateCloseOnExecSocketPair(Sockets);
+
+        std::cout.flush(); // Nothing buffered should be printed twice.
+        const pid_t ProcessID = ::fork();
+        if( ProcessID == 0 ) { // Zygote
+            ::close( Sockets[0] );
+            RunZygote(Sockets[1],Entry);
+        }
+
+        ::close( Sockets[1] );
+        if( ProcessID < 0 ) {
+            ::close( Sockets[0] );
+            throw std::runtime_error("Unable to fork process zygote.");
+        }
+        ControlSocket = Sockets[0];
+        ZygoteID = ProcessID;
+    }
+
+    ProcessZygote::~ProcessZygote()
+    {
+        ::close(ControlSocket); // The zygote exits when it sees this close.
+        while( ::waitpid(ZygoteID,nullptr,0) < 0 && errno == EINTR )
+            {}
+    }
+
+    Boole ProcessZygote::IsSupported()
+        { return true; }
+
+    Integer ProcessZygote::RunInChildStreaming(const StringView JobName,
+                                               const CommandOutputCallback& OnConsoleOutput,
+                                               const CommandOutputCallback& OnResultChannel,
+                                               const std::chrono::nanoseconds Timeout,
+                                               const std::atomic<Boole>* Cancel)
+    {
+        const StopCondition Stop{ StopAfter(Timeout,Cancel) };
+        // Output, result and status pipes in that order, each with its read end first.
+        int Pipes[ZygoteRequestFDCount][2];
+        for( size_t Created = 0 ; Created < ZygoteRequestFDCount ; ++Created )
+        {
+            try {
+                CreateCloseOnExecPipe(Pipes[Created]);
+            } catch (...) {
+                for( size_t Idx = 0 ; Idx < Created ; ++Idx )
+                    { ::close(Pipes[Idx][0]); ::close(Pipes[Idx][1]); }
+                throw;
+            }
+        }
+
+        const int ChildFDs[ZygoteRequestFDCount] = { Pipes[0][1], Pipes[1][1], Pipes[2][1] };
+        Boole Sent = false;
+        {
+            std::lock_guard<std::mutex> RequestLock(RequestMutex);
+            Sent = SendZygoteRequest(ControlSocket,JobName,ChildFDs);
+        }
+        // Only the job may hold the write ends, or reading would never see the end of them.
+        for( const int OneFD : ChildFDs )
+            { ::close(OneFD); }
+        if( !Sent ) {
+            for( const int (&OnePipe)[2] : Pipes )
+                { ::close(OnePipe[0]); }
+            throw std::runtime_error("Unable to send a job to the process zygote.");
+        }
+
+        // The watcher sends the ID of the job as soon as it has forked, or closes the pipe if it could not.
+        pid_t JobID = -1;
+        if( !ReadAll(Pipes[2][0],&JobID,sizeof(JobID)) ) {
+            JobID = -1;
+        }
+        const StopReason Stopped{ ReadProcessPipes(Pipes[0][0],Pipes[1][0],OnConsoleOutput,OnResultChannel,Stop) };
+        if( Stopped != StopReason::None && JobID > 0 ) {
+            // A status waiting to be read means the job has already been reaped and its ID could be reused.
+            pollfd StatusReady{ Pipes[2][0], POLLIN, 0 };
+            if( ::poll(&StatusReady,1,0) == 0 ) {
+                ::kill(JobID,SIGKILL);
+            }
+        }
+
+        int Status = -1;
+        Integer ExitCode = EXIT_FAILURE;
+        if( ReadAll(Pipes[2][0],&Status,sizeof(Status)) ) {
+            ExitCode = ExitCodeFromStatus(Status);
+        }
+        ::close(Pipes[2][0]);
+        return StoppedExitCode(Stopped,ExitCode);
+    }
+#endif // MEZZ_Windows
+
+    CommandResult ProcessZygote::RunInChild(const StringView JobName)
+    {
+        return CollectCommandResult([this,JobName](const CommandOutputCallback& OnConsoleOutput,
+                                                   const CommandOutputCallback& OnResultChannel)
+            { return RunInChildStreaming(JobName,OnConsoleOutput,OnResultChannel); }, true);
+    }
 }// Testing
 }// Mezzanine
@@ -44,19 +44,107 @@
 #include "MezzTest.h"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace
+{
+    using Mezzanine::Char8;
+    using Mezzanine::SizeType;
+    using Mezzanine::StringView;
+    using Mezzanine::UInt32;
+
+    /// @brief The size of every number in a binary test result record except the TestResult.
+    constexpr SizeType RecordNumberSize = 4;
+
+    /// @brief The size of the part of a record after its length that does not depend on the test.
+    constexpr SizeType RecordFixedBodySize = 1 + RecordNumberSize * 4;
+
+    /// @brief How many recently interned texts each thread checks before looking in the shared set.
+    constexpr SizeType RecentInternedCount = 4;
+
+    /// @brief Every text ever interned. The set never moves its elements, so views of them stay valid.
+    /// @return The one shared set, made the first time it is needed.
+    std::unordered_set<Mezzanine::String>& InternedText()
+    {
+        static std::unordered_set<Mezzanine::String> Interned;
+        return Interned;
+    }
+
+    /// @brief Protects the set returned by InternedText.
+    /// @return The one shared mutex, made the first time it is needed.
+    std::mutex& InternedTextMutex()
+    {
+        static std::mutex InternedMutex;
+        return InternedMutex;
+    }
+
+    /// @brief Append a number to a binary record, least significant byte first.
+    /// @param Number The value to write.
+    /// @param Buffer The record being built.
+    void AppendRecordNumber(const UInt32 Number, Mezzanine::String& Buffer)
+    {
+        for(SizeType Shift = 0; Shift < RecordNumberSize * 8; Shift += 8)
+            { Buffer.push_back(static_cast<Char8>((Number >> Shift) & 0xFF)); }
+    }
+
+    /// @brief Read a number written with AppendRecordNumber.
+    /// @param Buffer Text with at least RecordNumberSize bytes at Position.
+    /// @param Position Where the number starts, this is advanced past the number.
+    /// @return The number that was read.
+    UInt32 ReadRecordNumber(const StringView Buffer, SizeType& Position)
+    {
+        UInt32 Number{0};
+        for(SizeType Shift = 0; Shift < RecordNumberSize * 8; Shift += 8)
+            { Number |= static_cast<UInt32>(static_cast<unsigned char>(Buffer[Position++])) << Shift; }
+        return Number;
+    }
+
+    /// @brief Append a string to a binary record, its length then its bytes.
+    /// @param Text The string to write.
+    /// @param Buffer The record being built.
+    void AppendRecordString(const StringView Text, Mezzanine::String& Buffer)
+    {
+        AppendRecordNumber(static_cast<UInt32>(Text.size()), Buffer);
+        Buffer.append(Text.data(), Text.size());
+    }
+
+    /// @brief Read a string written with AppendRecordString without copying it.
+    /// @param Record Just the body of one record.
+    /// @param Position Where the string starts, this is advanced past the string.
+    /// @return A view of the string in the record.
+    StringView ReadRecordString(const StringView Record, SizeType& Position)
+    {
+        if(Record.size() - Position < RecordNumberSize)
+            { throw std::runtime_error("Test result record ended in the middle of a length."); }
+        const SizeType Length{ ReadRecordNumber(Record, Position) };
+        if(Record.size() - Position < Length)
+            { throw std::runtime_error("Test result record is shorter than a string it contains."); }
+        const StringView Text{ Record.substr(Position, Length) };
+        Position += Length;
+        return Text;
+    }
+}
 
 namespace Mezzanine
 {
     namespace Testing
     {
 
-        TestData::TestData(const String& Name,
+        TestData::TestData(String Name,
                  TestResult Result,
-                 const String& FuncName,
-                 const String& File,
+                 const StringView FuncName,
+                 const StringView File,
                  Mezzanine::Whole Line)
-            : TestName(Name), FunctionName(FuncName), FileName(File), LineNumber(Line), Results(Result)
+            : TestName(std::move(Name)),
+              FunctionName(InternTestText(FuncName)),
+              FileName(InternTestText(File)),
+              LineNumber(Line),
+              Results(Result)
         {}
 
         Boole TestData::operator<(const TestData& Rhs) const
@@ -76,6 +164,81 @@ namespace Mezzanine
                    Rhs.FunctionName != this->FunctionName;
         }
 
+        TestData TestDataView::ToTestData(const StringView NamePrefix) const
+        {
+            TestData Copied;
+            Copied.TestName.reserve(NamePrefix.size() + TestName.size());
+            Copied.TestName.append(NamePrefix.data(), NamePrefix.size()).append(TestName.data(), TestName.size());
+            Copied.FunctionName = InternTestText(FunctionName);
+            Copied.FileName = InternTestText(FileName);
+            Copied.LineNumber = LineNumber;
+            Copied.Results = Results;
+            return Copied;
+        }
+
+        StringView InternTestText(const StringView Text)
+        {
+            if(Text.empty())
+                { return StringView(); }
+
+            thread_local std::array<StringView, RecentInternedCount> RecentlyInterned{};
+            thread_local SizeType NextRecent{0};
+            for(const StringView OneRecent : RecentlyInterned)
+            {
+                if(OneRecent == Text)
+                    { return OneRecent; }
+            }
+
+            StringView Interned;
+            {
+                std::lock_guard<std::mutex> Lock(InternedTextMutex());
+                Interned = *InternedText().emplace(Text).first;
+            }
+            RecentlyInterned[NextRecent++ % RecentInternedCount] = Interned;
+            return Interned;
+        }
+
+        void AppendTestDataRecord(const TestData& ToWrite, Mezzanine::String& Buffer)
+        {
+            const SizeType BodySize{ RecordFixedBodySize + ToWrite.TestName.size() +
+                                     ToWrite.FunctionName.size() + ToWrite.FileName.size() };
+            Buffer.reserve(Buffer.size() + RecordNumberSize + BodySize);
+            AppendRecordNumber(static_cast<UInt32>(BodySize), Buffer);
+            Buffer.push_back(static_cast<Char8>(ToWrite.Results));
+            AppendRecordNumber(static_cast<UInt32>(std::min<Whole>(ToWrite.LineNumber,
+                                                                   std::numeric_limits<UInt32>::max())),
+                               Buffer);
+            AppendRecordString(ToWrite.TestName, Buffer);
+            AppendRecordString(ToWrite.FunctionName, Buffer);
+            AppendRecordString(ToWrite.FileName, Buffer);
+        }
+
+        SizeType ReadTestDataRecord(const StringView Buffer, TestDataView& Decoded)
+        {
+            if(Buffer.size() < RecordNumberSize)
+                { return 0; }
+            SizeType Position{0};
+            const SizeType BodySize{ ReadRecordNumber(Buffer, Position) };
+            if(Buffer.size() - RecordNumberSize < BodySize)
+                { return 0; }
+            if(BodySize < RecordFixedBodySize)
+                { throw std::runtime_error("Test result record is too short to hold a test result."); }
+
+            const StringView Record{ Buffer.substr(RecordNumberSize, BodySize) };
+            Position = 0;
+            const auto RawResult = static_cast<unsigned char>(Record[Position++]);
+            if(RawResult > static_cast<unsigned char>(TestResult::Highest))
+                { throw std::runtime_error("Test result record holds an invalid test result."); }
+            Decoded.Results = static_cast<TestResult>(RawResult);
+            Decoded.LineNumber = ReadRecordNumber(Record, Position);
+            Decoded.TestName = ReadRecordString(Record, Position);
+            Decoded.FunctionName = ReadRecordString(Record, Position);
+            Decoded.FileName = ReadRecordString(Record, Position);
+            if(Position != Record.size())
+                { throw std::runtime_error("Test result record is longer than its contents."); }
+            return RecordNumberSize + BodySize;
+        }
+
         SAVE_WARNING_STATE
         SUPPRESS_CLANG_WARNING("-Wexit-time-destructors")
         SUPPRESS_GCC_WARNING("-Wsign-conversion")
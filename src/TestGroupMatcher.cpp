@@ -0,0 +1,119 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the matcher for the names of test groups.
+
+#include "TestGroupMatcher.h"
+
+#include <algorithm>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        Boole TestGroupMatcher::IsGlob(const StringView Pattern)
+            { return StringView::npos != Pattern.find_first_of("*?"); }
+
+        Boole TestGroupMatcher::GlobMatches(const StringView Glob, const StringView Text)
+        {
+            // Walk both once, going back to just after the last '*' when a mismatch happens after it.
+            SizeType G{0};
+            SizeType T{0};
+            SizeType StarAt{StringView::npos};
+            SizeType StarText{0};
+            while(T < Text.size())
+            {
+                if(G < Glob.size() && '*' == Glob[G])
+                {
+                    StarAt = G++;
+                    StarText = T;
+                } else if(G < Glob.size() && ('?' == Glob[G] || Glob[G] == Text[T])) {
+                    ++G;
+                    ++T;
+                } else if(StringView::npos != StarAt) {
+                    G = StarAt + 1;
+                    T = ++StarText;
+                } else {
+                    return false;
+                }
+            }
+            while(G < Glob.size() && '*' == Glob[G])
+                { ++G; }
+            return Glob.size() == G;
+        }
+
+        void TestGroupMatcher::AddName(const StringView Name)
+            { Names.emplace(Name); }
+
+        void TestGroupMatcher::AddGlob(const StringView Glob)
+            { Globs.emplace_back(Glob); }
+
+        void TestGroupMatcher::AddRegex(const StringView Regex)
+        {
+            // Check this one alone first so a bad one cannot break those already added.
+            std::regex(Regex.begin(), Regex.end(), std::regex::ECMAScript | std::regex::icase);
+            RegexSource += (HasRegex ? "|(?:" : "(?:") + String(Regex) + ")";
+            Combined.assign(RegexSource, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+            HasRegex = true;
+        }
+
+        void TestGroupMatcher::AddNameOrGlob(const StringView Pattern)
+        {
+            if(IsGlob(Pattern))
+                { AddGlob(Pattern); }
+            else
+                { AddName(Pattern); }
+        }
+
+        Boole TestGroupMatcher::Empty() const
+            { return Names.empty() && Globs.empty() && !HasRegex; }
+
+        Boole TestGroupMatcher::Matches(const String& LowerName) const
+        {
+            if(Names.count(LowerName))
+                { return true; }
+            if(std::any_of(Globs.cbegin(), Globs.cend(),
+                           [&LowerName](const String& OneGlob){ return GlobMatches(OneGlob, LowerName); }))
+                { return true; }
+            return HasRegex && std::regex_match(LowerName, Combined);
+        }
+    }// Testing
+}// Mezzanine
@@ -0,0 +1,88 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the registry of test groups that are created only when selected.
+
+#include "TestGroupRegistry.h"
+#include "StringManipulation.h"
+
+#include <stdexcept>
+
+namespace
+{
+    /// @brief The one registry every registrar in the executable adds to.
+    /// @return A reference to the function local static registry.
+    Mezzanine::Testing::TestGroupFactoryMap& MutableRegisteredTestGroups()
+    {
+        static Mezzanine::Testing::TestGroupFactoryMap Registry;
+        return Registry;
+    }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        const TestGroupFactoryMap& RegisteredTestGroups()
+            { return MutableRegisteredTestGroups(); }
+
+        std::unique_ptr<UnitTestGroup> CreateNamedTestGroup(const StringView GroupName,
+                                                            const TestGroupFactory& Factory)
+        {
+            std::unique_ptr<UnitTestGroup> Created = Factory();
+            if(AllLower(Created->Name()) != AllLower(GroupName))
+            {
+                throw std::logic_error("Test group registered as '" + String(GroupName) + "' is named '" +
+                                       Created->Name() + "', these must match so the group can be found by name.");
+            }
+            return Created;
+        }
+
+        void RegisterTestGroup(const StringView GroupName, TestGroupFactory Factory)
+        {
+            const String RegisteredName(GroupName);
+            TestGroupFactory CheckedFactory = [RegisteredName, Factory = std::move(Factory)]
+                { return CreateNamedTestGroup(RegisteredName, Factory); };
+            if(!MutableRegisteredTestGroups().emplace(AllLower(GroupName), std::move(CheckedFactory)).second)
+                { throw std::invalid_argument("Test group '" + String(GroupName) + "' was registered twice."); }
+        }
+    }// Testing
+}// Mezzanine
@@ -0,0 +1,318 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The implementation of the tools for remembering how long test groups took.
+
+#include "TestHistory.h"
+#include "JunitWriter.h"
+#include "MezzTest.h"
+#include "StringManipulation.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <unordered_map>
+
+namespace
+{
+    using namespace Mezzanine;
+    using namespace Mezzanine::Testing;
+
+    /// @brief Check if a String ends with another.
+    /// @param Text The String to inspect.
+    /// @param Suffix The String that might be at the end of Text.
+    /// @return True if the last characters of Text are Suffix.
+    Boole EndsWith(const String& Text, const String& Suffix)
+    {
+        return Text.size() >= Suffix.size() &&
+               0 == Text.compare(Text.size() - Suffix.size(), Suffix.size(), Suffix);
+    }
+
+    /// @brief Continue an FNV-1a hash with more bytes.
+    /// @param Hash The hash so far, start with the FNV-1a offset basis.
+    /// @param Data The first byte to add.
+    /// @param Size How many bytes to add.
+    /// @return The hash including the new bytes.
+    UInt64 StableHashAppend(UInt64 Hash, const char* Data, const SizeType Size)
+    {
+        for(SizeType Index = 0; Index < Size; ++Index)
+        {
+            Hash ^= static_cast<unsigned char>(Data[Index]);
+            Hash *= 1099511628211ULL;
+        }
+        return Hash;
+    }
+
+    /// @brief A hash of a name that is the same on every platform and every run, unlike std::hash.
+    /// @param Name The text to hash.
+    /// @return The 64 bit FNV-1a hash of the name.
+    UInt64 StableNameHash(const String& Name)
+        { return StableHashAppend(14695981039346656037ULL, Name.data(), Name.size()); }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        TestDurationHistory LoadTestHistory(std::istream& HistoryStream)
+        {
+            TestDurationHistory History;
+            String OneLine;
+            while(std::getline(HistoryStream, OneLine))
+            {
+                const String::size_type Split{ OneLine.find(' ') };
+                if(String::npos == Split || 0 == Split)
+                    { continue; }
+
+                char* CountEnd = nullptr;
+                const long long Count{ std::strtoll(OneLine.c_str(), &CountEnd, 10) };
+                if(OneLine.c_str() + Split != CountEnd || 0 > Count)
+                    { continue; }
+
+                const String Name{ RightTrim(OneLine.substr(Split + 1)) };
+                if(!Name.empty())
+                    { History[Name] = std::chrono::nanoseconds{Count}; }
+            }
+            return History;
+        }
+
+        void SaveTestHistory(const TestDurationHistory& History, std::ostream& HistoryStream)
+        {
+            for(const TestDurationHistory::value_type& Entry : History)
+                { HistoryStream << Entry.second.count() << ' ' << Entry.first << '\n'; }
+        }
+
+        void UpdateTestHistory(TestDurationHistory& History, const std::vector<NamedDuration>& Timings)
+        {
+            for(const NamedDuration& OneTiming : Timings)
+            {
+                if(EndsWith(OneTiming.Name, ParallelTimingSuffix))
+                    { History[OneTiming.Name.substr(0, OneTiming.Name.size() - ParallelTimingSuffix.size())] =
+                        OneTiming.Duration; }
+                else if(EndsWith(OneTiming.Name, SerialTimingSuffix))
+                    { History[OneTiming.Name.substr(0, OneTiming.Name.size() - SerialTimingSuffix.size())] =
+                        OneTiming.Duration; }
+            }
+        }
+
+        void SortTestsByHistory(std::vector<UnitTestGroup*>& Tests, const TestDurationHistory& History)
+        {
+            if(History.empty())
+                { return; }
+
+            // Look each duration up once, a group with no history is treated as the longest possible.
+            using PlannedTest = std::pair<std::chrono::nanoseconds, UnitTestGroup*>;
+            std::vector<PlannedTest> Plan;
+            Plan.reserve(Tests.size());
+            for(UnitTestGroup* OneTest : Tests)
+            {
+                const TestDurationHistory::const_iterator Found{ History.find(OneTest->Name()) };
+                Plan.emplace_back(History.cend() == Found ? std::chrono::nanoseconds::max() : Found->second, OneTest);
+            }
+
+            std::stable_sort(Plan.begin(), Plan.end(),
+                             [](const PlannedTest& Lhs, const PlannedTest& Rhs){ return Lhs.first > Rhs.first; });
+            std::transform(Plan.cbegin(), Plan.cend(), Tests.begin(),
+                           [](const PlannedTest& Planned){ return Planned.second; });
+        }
+
+        void SelectShard(std::vector<UnitTestGroup*>& Tests,
+                         const Whole ShardIndex,
+                         const Whole ShardCount,
+                         const TestDurationHistory& History)
+        {
+            if(1 >= ShardCount)
+                { return; }
+
+            // Deal timed groups out longest first in a fixed order, names break ties so every shard agrees.
+            using TimedTest = std::pair<std::chrono::nanoseconds, String>;
+            std::vector<TimedTest> Timed;
+            for(const UnitTestGroup* OneTest : Tests)
+            {
+                const TestDurationHistory::const_iterator Found{ History.find(OneTest->Name()) };
+                if(History.cend() != Found)
+                    { Timed.emplace_back(Found->second, Found->first); }
+            }
+            std::sort(Timed.begin(), Timed.end(), [](const TimedTest& Lhs, const TimedTest& Rhs)
+                { return Lhs.first != Rhs.first ? Lhs.first > Rhs.first : Lhs.second < Rhs.second; });
+
+            std::vector<std::chrono::nanoseconds> ShardLoads(ShardCount, std::chrono::nanoseconds{0});
+            std::map<String, Whole> TimedShards;
+            for(const TimedTest& OneTimed : Timed)
+            {
+                const Whole LeastLoaded{ static_cast<Whole>(
+                    std::min_element(ShardLoads.cbegin(), ShardLoads.cend()) - ShardLoads.cbegin()) };
+                ShardLoads[LeastLoaded] += OneTimed.first;
+                TimedShards[OneTimed.second] = LeastLoaded;
+            }
+
+            const auto InOtherShard = [&](const UnitTestGroup* OneTest)
+            {
+                const String Name{ OneTest->Name() };
+                const std::map<String, Whole>::const_iterator Found{ TimedShards.find(Name) };
+                if(TimedShards.cend() != Found)
+                    { return ShardIndex != Found->second; }
+                return ShardIndex != static_cast<Whole>(StableNameHash(Name) % ShardCount);
+            };
+            Tests.erase(std::remove_if(Tests.begin(), Tests.end(), InOtherShard), Tests.end());
+        }
+
+        UInt64 HashFileContents(const String& FileName)
+        {
+            std::ifstream File(FileName, std::ios::binary);
+            if(!File)
+                { return 0; }
+
+            UInt64 Hash{ StableNameHash(String()) };
+            std::vector<char> Chunk(1 << 16);
+            while(File)
+            {
+                File.read(Chunk.data(), static_cast<std::streamsize>(Chunk.size()));
+                Hash = StableHashAppend(Hash, Chunk.data(), static_cast<SizeType>(File.gcount()));
+            }
+            return File.eof() ? Hash : 0;
+        }
+
+        UInt64 IncrementalKeyOf(const UnitTestGroup& Group, const UInt64 ExecutableHash)
+        {
+            const String Name{ Group.Name() };
+            const String Key{ Group.IncrementalKey() };
+            UInt64 Hash{ StableHashAppend(StableNameHash(Name), reinterpret_cast<const char*>(&ExecutableHash),
+                                          sizeof(ExecutableHash)) };
+            return StableHashAppend(Hash, Key.data(), Key.size());
+        }
+
+        IncrementalHistory LoadIncrementalHistory(std::istream& HistoryStream)
+        {
+            IncrementalHistory History;
+            String OneLine;
+            while(std::getline(HistoryStream, OneLine))
+            {
+                char* KeyEnd = nullptr;
+                const UInt64 Key{ std::strtoull(OneLine.c_str(), &KeyEnd, 16) };
+                if(OneLine.c_str() == KeyEnd || ' ' != *KeyEnd)
+                    { continue; }
+
+                char* ResultEnd = nullptr;
+                const unsigned long Result{ std::strtoul(KeyEnd + 1, &ResultEnd, 10) };
+                if(KeyEnd + 1 == ResultEnd || ' ' != *ResultEnd ||
+                   TestResultToUnsignedInt(TestResult::Highest) < Result)
+                    { continue; }
+
+                const String Name{ RightTrim(String(ResultEnd + 1)) };
+                if(!Name.empty())
+                    { History[Name] = IncrementalRecord{ Key, IntToTestResult(Result) }; }
+            }
+            return History;
+        }
+
+        void SaveIncrementalHistory(const IncrementalHistory& History, std::ostream& HistoryStream)
+        {
+            const std::ios::fmtflags OldFlags{ HistoryStream.flags() };
+            for(const IncrementalHistory::value_type& Entry : History)
+            {
+                HistoryStream << std::hex << Entry.second.Key << ' '
+                              << std::dec << TestResultToUnsignedInt(Entry.second.Worst) << ' '
+                              << Entry.first << '\n';
+            }
+            HistoryStream.flags(OldFlags);
+        }
+
+        UnitTestGroup::TestDataStorageType SkipUnchangedTests(std::vector<UnitTestGroup*>& Tests,
+                                                              const IncrementalHistory& History,
+                                                              const UInt64 ExecutableHash)
+        {
+            UnitTestGroup::TestDataStorageType CacheHits;
+            if(0 == ExecutableHash || History.empty())
+                { return CacheHits; }
+
+            const auto IsUnchanged = [&](UnitTestGroup* OneTest)
+            {
+                const String Name{ OneTest->Name() };
+                const IncrementalHistory::const_iterator Found{ History.find(Name) };
+                if(History.cend() == Found || TestResult::Warning <= Found->second.Worst ||
+                   IncrementalKeyOf(*OneTest, ExecutableHash) != Found->second.Key)
+                    { return false; }
+                CacheHits.emplace_back(Name + "::" + CacheHitTestName, TestResult::Skipped, "", "", 0);
+                return true;
+            };
+            Tests.erase(std::remove_if(Tests.begin(), Tests.end(), IsUnchanged), Tests.end());
+            return CacheHits;
+        }
+
+        void UpdateIncrementalHistory(IncrementalHistory& History,
+                                      const std::vector<UnitTestGroup*>& Ran,
+                                      const UnitTestGroup::TestDataStorageType& AllResults,
+                                      const UInt64 ExecutableHash)
+        {
+            // Results are named for their group, so the worst of each group can be found in one pass. A group that
+            // was cancelled or timed out may not have run every test, whatever the worst of what it did run was.
+            struct GroupOutcome
+            {
+                TestResult Worst;
+                Boole Incomplete;
+            };
+            const String TimeoutSuffix{ "::" + TimeoutTestName };
+            std::unordered_map<String, GroupOutcome> OutcomeByGroup;
+            for(const TestData& OneResult : AllResults)
+            {
+                const String Group{ JunitWriter::GroupNameOf(OneResult.TestName) };
+                GroupOutcome& Outcome{
+                    OutcomeByGroup.emplace(Group, GroupOutcome{TestResult::Success, false}).first->second };
+                Outcome.Worst = std::max(Outcome.Worst, OneResult.Results);
+                if(TestResult::Cancelled == OneResult.Results || EndsWith(OneResult.TestName, TimeoutSuffix))
+                    { Outcome.Incomplete = true; }
+            }
+
+            for(const UnitTestGroup* OneTest : Ran)
+            {
+                const String Name{ OneTest->Name() };
+                const auto Found = OutcomeByGroup.find(Name);
+                if(OutcomeByGroup.cend() != Found && Found->second.Incomplete)
+                    { History.erase(Name); }
+                else if(OutcomeByGroup.cend() != Found)
+                    { History[Name] = { IncrementalKeyOf(*OneTest, ExecutableHash), Found->second.Worst }; }
+                else if(0 != OneTest->GetUnstoredSuccessCount())
+                    { History[Name] = { IncrementalKeyOf(*OneTest, ExecutableHash), TestResult::Success }; }
+            }
+        }
+    }// Testing
+}// Mezzanine
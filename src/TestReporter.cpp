@@ -0,0 +1,311 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the reporters that stream test results out as they arrive.
+
+#include "TestReporter.h"
+#include "TestEnumerations.h"
+
+#include <cstdio>
+
+namespace
+{
+    using Mezzanine::StringView;
+
+    /// @brief Write text as the inside of a JSON string.
+    /// @param Output The stream to write to.
+    /// @param Text The text to escape.
+    void WriteJsonString(std::ostream& Output, const StringView Text)
+    {
+        Output << '"';
+        for(const char OneLetter : Text)
+        {
+            switch(OneLetter)
+            {
+                case '"':   Output << "\\\""; break;
+                case '\\':  Output << "\\\\"; break;
+                case '\n':  Output << "\\n"; break;
+                case '\r':  Output << "\\r"; break;
+                case '\t':  Output << "\\t"; break;
+                default:
+                    if(0x20 > static_cast<unsigned char>(OneLetter))
+                    {
+                        char Escaped[8];
+                        std::snprintf(Escaped, sizeof(Escaped), "\\u%04x", static_cast<unsigned>(OneLetter));
+                        Output << Escaped;
+                    } else {
+                        Output << OneLetter;
+                    }
+            }
+        }
+        Output << '"';
+    }
+
+    /// @brief Write text as a single quoted YAML string, where the only escape is doubling single quotes.
+    /// @param Output The stream to write to.
+    /// @param Text The text to write.
+    void WriteYamlString(std::ostream& Output, const StringView Text)
+    {
+        Output << '\'';
+        for(const char OneLetter : Text)
+        {
+            if('\'' == OneLetter)
+                { Output << '\''; }
+            Output << OneLetter;
+        }
+        Output << '\'';
+    }
+
+    /// @brief Test point descriptions cannot contain '#', it would start a directive, or a line break.
+    /// @param Output The stream to write to.
+    /// @param Text The text to write.
+    void WriteTapDescription(std::ostream& Output, const StringView Text)
+    {
+        for(const char OneLetter : Text)
+        {
+            switch(OneLetter)
+            {
+                case '#':   Output << "\\#"; break;
+                case '\\':  Output << "\\\\"; break;
+                case '\n':  Output << ' '; break;
+                default:    Output << OneLetter;
+            }
+        }
+    }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        // TestReporter
+
+        void TestReporter::BeginRun()
+            {}
+
+        void TestReporter::EndRun(const Whole)
+            {}
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        // JsonLinesReporter
+
+        JsonLinesReporter::JsonLinesReporter(std::ostream& Destination)
+            : Output(Destination)
+            {}
+
+        void JsonLinesReporter::ReportResults(ResultIterator First, ResultIterator Last)
+        {
+            for(; First != Last; ++First)
+            {
+                Output << "{\"event\":\"result\",\"name\":";
+                WriteJsonString(Output, First->TestName);
+                Output << ",\"result\":";
+                WriteJsonString(Output, TestResultToString(First->Results));
+                Output << ",\"function\":";
+                WriteJsonString(Output, First->FunctionName);
+                Output << ",\"file\":";
+                WriteJsonString(Output, First->FileName);
+                Output << ",\"line\":" << First->LineNumber << "}\n";
+            }
+            Output.flush();
+        }
+
+        void JsonLinesReporter::EndRun(const Whole UnstoredSuccesses)
+        {
+            Output << "{\"event\":\"end\",\"unstored_successes\":" << UnstoredSuccesses << "}\n";
+            Output.flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        // TapReporter
+
+        TapReporter::TapReporter(std::ostream& Destination)
+            : Output(Destination)
+            {}
+
+        void TapReporter::BeginRun()
+        {
+            Output << "TAP version 13\n";
+            Output.flush();
+        }
+
+        void TapReporter::ReportResults(ResultIterator First, ResultIterator Last)
+        {
+            for(; First != Last; ++First)
+            {
+                const Boole Passed{ TestResult::Success == First->Results || TestResult::Skipped == First->Results };
+                Output << (Passed ? "ok " : "not ok ") << ++TestCount << " - ";
+                WriteTapDescription(Output, First->TestName);
+                if(TestResult::Skipped == First->Results)
+                    { Output << " # SKIP"; }
+                Output << '\n';
+
+                if(!Passed)
+                {
+                    Output << "  ---\n"
+                           << "  result: " << TestResultToString(First->Results) << "\n  function: ";
+                    WriteYamlString(Output, First->FunctionName);
+                    Output << "\n  file: ";
+                    WriteYamlString(Output, First->FileName);
+                    Output << "\n  line: " << First->LineNumber << "\n  ...\n";
+                }
+            }
+            Output.flush();
+        }
+
+        void TapReporter::EndRun(const Whole UnstoredSuccesses)
+        {
+            if(0 != UnstoredSuccesses)
+                { Output << "# " << UnstoredSuccesses << " more successes were counted but not listed\n"; }
+            Output << "1.." << TestCount << '\n';
+            Output.flush();
+        }
+
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        // TestReporterList
+
+        TestReporterList::TestReporterList()
+            : ReporterThread(&TestReporterList::ReportUntilStopped, this)
+            {}
+
+        TestReporterList::~TestReporterList()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(PendingMutex);
+                Stopping = true;
+            }
+            PendingChanged.notify_one();
+            ReporterThread.join();
+        }
+
+        void TestReporterList::ReportUntilStopped()
+        {
+            // Everything pending is taken at once so the lock is never held while reporting.
+            std::vector<std::function<void()>> ToReport;
+            std::unique_lock<std::mutex> Lock(PendingMutex);
+            while(true)
+            {
+                PendingChanged.wait(Lock, [this]{ return Stopping || !PendingCalls.empty(); });
+                if(PendingCalls.empty())
+                    { break; }
+                ToReport.swap(PendingCalls);
+                Busy = true;
+                Lock.unlock();
+
+                for(const std::function<void()>& OneCall : ToReport)
+                    { OneCall(); }
+                ToReport.clear();
+
+                Lock.lock();
+                Busy = false;
+                if(PendingCalls.empty())
+                    { AllReported.notify_all(); }
+            }
+        }
+
+        void TestReporterList::Queue(std::function<void()> Call)
+        {
+            {
+                std::lock_guard<std::mutex> Lock(PendingMutex);
+                PendingCalls.push_back(std::move(Call));
+            }
+            PendingChanged.notify_one();
+        }
+
+        void TestReporterList::Add(std::unique_ptr<TestReporter> NewReporter)
+            { Reporters.push_back(std::move(NewReporter)); }
+
+        Boole TestReporterList::Empty() const
+            { return Reporters.empty(); }
+
+        void TestReporterList::WaitUntilReported()
+        {
+            std::unique_lock<std::mutex> Lock(PendingMutex);
+            AllReported.wait(Lock, [this]{ return !Busy && PendingCalls.empty(); });
+        }
+
+        Boole TestReporterList::WaitUntilReported(const std::chrono::nanoseconds Timeout)
+        {
+            std::unique_lock<std::mutex> Lock(PendingMutex);
+            return AllReported.wait_for(Lock, Timeout, [this]{ return !Busy && PendingCalls.empty(); });
+        }
+
+        void TestReporterList::BeginRun()
+        {
+            Queue([this]
+            {
+                for(std::unique_ptr<TestReporter>& OneReporter : Reporters)
+                    { OneReporter->BeginRun(); }
+            });
+        }
+
+        void TestReporterList::ReportResults(ResultIterator First, ResultIterator Last)
+        {
+            Queue([this, Results = UnitTestGroup::TestDataStorageType(First, Last)]
+            {
+                for(std::unique_ptr<TestReporter>& OneReporter : Reporters)
+                    { OneReporter->ReportResults(Results.cbegin(), Results.cend()); }
+            });
+        }
+
+        void TestReporterList::QueueEndRun(const Whole UnstoredSuccesses)
+        {
+            Queue([this, UnstoredSuccesses]
+            {
+                for(std::unique_ptr<TestReporter>& OneReporter : Reporters)
+                    { OneReporter->EndRun(UnstoredSuccesses); }
+            });
+        }
+
+        void TestReporterList::EndRun(const Whole UnstoredSuccesses)
+        {
+            QueueEndRun(UnstoredSuccesses);
+            WaitUntilReported();
+        }
+
+        Boole TestReporterList::EndRunWithin(const Whole UnstoredSuccesses, const std::chrono::nanoseconds Timeout)
+        {
+            QueueEndRun(UnstoredSuccesses);
+            return WaitUntilReported(Timeout);
+        }
+    }// Testing
+}// Mezzanine
@@ -0,0 +1,225 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of the crash safe log of results.
+
+#include "TestResultLog.h"
+#include "JunitWriter.h"
+
+#ifdef MEZZ_Windows
+    #include <io.h>
+    #include <fcntl.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+    /// @brief Open a file for writing, replacing anything in it.
+    /// @param FileName The file to open.
+    /// @return A file descriptor or -1 on failure.
+    int OpenLogFile(const Mezzanine::String& FileName)
+    {
+    #ifdef MEZZ_Windows
+        return _open(FileName.c_str(),
+                     _O_WRONLY | _O_CREAT | _O_TRUNC | _O_APPEND | _O_BINARY,
+                     _S_IREAD | _S_IWRITE);
+    #else
+        return open(FileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    #endif
+    }
+
+    /// @brief Write some bytes to a file, retrying when interrupted or only partly written.
+    /// @param FileDescriptor The file to write to.
+    /// @param Data The first byte to write.
+    /// @param Size How many bytes to write.
+    /// @return True if every byte was written.
+    Mezzanine::Boole WriteAll(const int FileDescriptor, const char* Data, Mezzanine::SizeType Size)
+    {
+        while(0 < Size)
+        {
+        #ifdef MEZZ_Windows
+            const int Result{ _write(FileDescriptor, Data, static_cast<unsigned int>(Size)) };
+        #else
+            const ssize_t Result{ write(FileDescriptor, Data, Size) };
+        #endif
+            if(0 > Result)
+            {
+                if(EINTR == errno)
+                    { continue; }
+                return false;
+            }
+            Data += Result;
+            Size -= static_cast<Mezzanine::SizeType>(Result);
+        }
+        return true;
+    }
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        constexpr std::chrono::milliseconds TestResultLog::SyncInterval;
+        const StringView TestResultLog::IndexHeader{"--= Index =--\n"};
+        const StringView TestResultLog::IndexLocationPrefix{"--= Index At "};
+
+        TestResultLog::TestResultLog(const String& FileName)
+            : LastSync(std::chrono::steady_clock::now()),
+              FileDescriptor(OpenLogFile(FileName))
+        {
+            if(!IsOpen())
+                { std::cerr << "Could not open '" << FileName << "': " << std::strerror(errno) << std::endl; }
+        }
+
+        TestResultLog::~TestResultLog()
+        {
+            if(!IsOpen())
+                { return; }
+            Sync();
+        #ifdef MEZZ_Windows
+            _close(FileDescriptor);
+        #else
+            close(FileDescriptor);
+        #endif
+        }
+
+        void TestResultLog::Append(const String& Text)
+        {
+            if(WriteAll(FileDescriptor, Text.data(), Text.size()))
+                { Written += Text.size(); }
+        }
+
+        void TestResultLog::Sync()
+        {
+        #ifdef MEZZ_Windows
+            _commit(FileDescriptor);
+        #else
+            fsync(FileDescriptor);
+        #endif
+            LastSync = std::chrono::steady_clock::now();
+            UnsyncedGroups = 0;
+        }
+
+        Boole TestResultLog::IsOpen() const
+            { return 0 <= FileDescriptor; }
+
+        void TestResultLog::ReportResults(ResultIterator First, ResultIterator Last)
+        {
+            if(!IsOpen() || First == Last)
+                { return; }
+
+            Rendered.str(String());
+            for(ResultIterator Current = First; Current != Last; ++Current)
+                { Rendered << *Current; }
+            const String Text{ Rendered.str() };
+
+            const UInt64 Offset{ Written };
+            Append(Text);
+            Index.push_back( {String(JunitWriter::GroupNameOf(First->TestName)), Offset, Written - Offset} );
+
+            if(SyncEveryGroups <= ++UnsyncedGroups || SyncInterval <= std::chrono::steady_clock::now() - LastSync)
+                { Sync(); }
+        }
+
+        void TestResultLog::EndRun(const Whole)
+        {
+            if(!IsOpen())
+                { return; }
+
+            std::ostringstream Footer;
+            const UInt64 IndexOffset{ Written };
+            Footer << IndexHeader;
+            for(const TestResultLogIndexEntry& OneEntry : Index)
+                { Footer << OneEntry.Offset << ' ' << OneEntry.Length << ' ' << OneEntry.GroupName << '\n'; }
+            Footer << IndexLocationPrefix << IndexOffset << " =--\n";
+            Append(Footer.str());
+            Sync();
+        }
+
+        std::vector<TestResultLogIndexEntry> ReadTestResultLogIndex(std::istream& Log)
+        {
+            std::vector<TestResultLogIndexEntry> Results;
+
+            // The last line is short, so only the end of the file needs reading to find it.
+            Log.seekg(0, std::ios::end);
+            const std::streamoff FileSize{ Log.tellg() };
+            const std::streamoff TailSize{ std::min<std::streamoff>(FileSize, 64) };
+            if(0 >= TailSize)
+                { return Results; }
+            String Tail(static_cast<SizeType>(TailSize), '\0');
+            Log.seekg(FileSize - TailSize);
+            Log.read(&Tail[0], TailSize);
+
+            const SizeType LocationAt{ StringView(Tail).rfind(TestResultLog::IndexLocationPrefix) };
+            if(String::npos == LocationAt)
+                { return Results; }
+            std::istringstream Location(Tail.substr(LocationAt + TestResultLog::IndexLocationPrefix.size()));
+            std::streamoff IndexOffset{0};
+            if(!(Location >> IndexOffset) || 0 > IndexOffset || FileSize <= IndexOffset)
+                { return Results; }
+
+            Log.clear();
+            Log.seekg(IndexOffset);
+            String Line;
+            if(!std::getline(Log, Line) || Line + '\n' != TestResultLog::IndexHeader)
+                { return Results; }
+            while(std::getline(Log, Line) && 0 != StringView(Line).compare(0, TestResultLog::IndexLocationPrefix.size(),
+                                                                          TestResultLog::IndexLocationPrefix))
+            {
+                // Each entry is "Offset Length Name", the name is the rest of the line.
+                std::istringstream EntryStream(Line);
+                TestResultLogIndexEntry OneEntry;
+                EntryStream >> OneEntry.Offset >> OneEntry.Length;
+                EntryStream.ignore(1);
+                if(EntryStream && std::getline(EntryStream, OneEntry.GroupName))
+                    { Results.push_back(std::move(OneEntry)); }
+            }
+            return Results;
+        }
+    }// Testing
+}// Mezzanine
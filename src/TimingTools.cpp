@@ -44,8 +44,12 @@
 #include "TimingTools.h"
 #include "MezzTest.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
-#include <numeric>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 using std::chrono::minutes;
 using std::chrono::seconds;
@@ -72,6 +76,202 @@ namespace
         Duration -= TruncateAmount;
         return Duration;
     }
+
+    /// @internal
+    /// @brief How many empty timings are thrown away before calibrating, to get the clock code into cache.
+    const Mezzanine::SizeType CalibrationWarmupCount{1000};
+    /// @internal
+    /// @brief How many empty timings the timer overhead is calculated from.
+    const Mezzanine::SizeType CalibrationSampleCount{10000};
+    /// @internal
+    /// @brief How many clock ticks are watched for to find the smallest.
+    const Mezzanine::SizeType ResolutionSampleCount{100};
+
+    /// @internal
+    /// @brief Find the smallest step the clock takes by spinning until it changes.
+    /// @return The shortest nonzero difference between two reads of the clock.
+    nanoseconds MeasureClockResolution()
+    {
+        nanoseconds Smallest{nanoseconds::max()};
+        for(Mezzanine::SizeType Counter{0}; Counter < ResolutionSampleCount; Counter++)
+        {
+            const std::chrono::high_resolution_clock::time_point Begin{std::chrono::high_resolution_clock::now()};
+            std::chrono::high_resolution_clock::time_point Current{std::chrono::high_resolution_clock::now()};
+            while(Begin == Current)
+                { Current = std::chrono::high_resolution_clock::now(); }
+            Smallest = std::min(Smallest, duration_cast<nanoseconds>(Current - Begin));
+        }
+        return Smallest;
+    }
+
+    /// @internal
+    /// @brief The median of some timings, without changing them.
+    /// @param Timings At least one timing.
+    /// @return The timing in the middle, or the later of the two in the middle.
+    nanoseconds MedianOf(Mezzanine::Testing::MicroBenchmarkResults::TimingLists Timings)
+    {
+        const auto Middle = Timings.begin() + static_cast<std::ptrdiff_t>(Timings.size() / 2);
+        std::nth_element(Timings.begin(), Middle, Timings.end());
+        return *Middle;
+    }
+
+    /// @internal
+    /// @brief The mean and sample standard deviation of some timings in nanoseconds.
+    /// @param Timings Some timings.
+    /// @return The mean first then the standard deviation, both zero when there are fewer than two timings.
+    std::pair<Mezzanine::PreciseReal, Mezzanine::PreciseReal>
+    MeanAndDeviationOf(const Mezzanine::Testing::MicroBenchmarkResults::TimingLists& Timings)
+    {
+        if(Timings.size() < 2)
+            { return { 0.0, 0.0 }; }
+
+        const Mezzanine::PreciseReal Count{ static_cast<Mezzanine::PreciseReal>(Timings.size()) };
+        Mezzanine::PreciseReal Mean{0.0};
+        for(const nanoseconds OneTiming : Timings)
+            { Mean += static_cast<Mezzanine::PreciseReal>(OneTiming.count()); }
+        Mean /= Count;
+
+        Mezzanine::PreciseReal SquaredDeviations{0.0};
+        for(const nanoseconds OneTiming : Timings)
+        {
+            const Mezzanine::PreciseReal Deviation{ static_cast<Mezzanine::PreciseReal>(OneTiming.count()) - Mean };
+            SquaredDeviations += Deviation * Deviation;
+        }
+        return { Mean, std::sqrt(SquaredDeviations / (Count - 1.0)) };
+    }
+
+    /// @internal
+    /// @brief The percentiles every MicroBenchmarkResults has, from Fastest to Slowest.
+    const Mezzanine::PreciseReal FixedPercents[]{ 0.0, 0.01, 0.10, 0.5, 0.90, 0.99, 1.0 };
+
+    /// @internal
+    /// @brief Where a timing a percentage into some sorted timings would be.
+    /// @param Count How many timings there are, at least one.
+    /// @param Percent Where to reach into the timings. With 1.0 the slowest and 0.0 the fastest.
+    /// @return An index less than Count.
+    Mezzanine::SizeType IndexOfPercent(const Mezzanine::SizeType Count, Mezzanine::PreciseReal Percent)
+    {
+        if(0.0 > Percent)
+            { Percent = 0.0; }
+        if(1.0 < Percent)
+            { Percent = 1.0; }
+        const Mezzanine::SizeType Location{
+            static_cast<Mezzanine::SizeType>(static_cast<Mezzanine::PreciseReal>(Count) * Percent) };
+        return std::min(Location, Count - 1);
+    }
+
+    /// @internal
+    /// @brief Partly order timings so each of several indexes holds what it would if they were sorted.
+    /// @details Selecting the middle index splits the range, then each half is done the same way for the indexes
+    /// in it. For a handful of indexes this is linear in the number of timings, unlike a sort.
+    /// @param Base The start of all the timings, the indexes count from here.
+    /// @param First The start of the timings still to partition.
+    /// @param Last One past the end of the timings still to partition.
+    /// @param IndexFirst The first of the indexes in [First, Last), sorted and without duplicates.
+    /// @param IndexLast One past the last of those indexes.
+    void SelectIndexes(const Mezzanine::Testing::MicroBenchmarkResults::TimingLists::iterator Base,
+                       const Mezzanine::Testing::MicroBenchmarkResults::TimingLists::iterator First,
+                       const Mezzanine::Testing::MicroBenchmarkResults::TimingLists::iterator Last,
+                       const Mezzanine::SizeType* IndexFirst,
+                       const Mezzanine::SizeType* IndexLast)
+    {
+        if(IndexFirst == IndexLast)
+            { return; }
+        const Mezzanine::SizeType* IndexMiddle{ IndexFirst + (IndexLast - IndexFirst) / 2 };
+        const auto Nth = Base + static_cast<std::ptrdiff_t>(*IndexMiddle);
+        std::nth_element(First, Nth, Last);
+        SelectIndexes(Base, First, Nth, IndexFirst, IndexMiddle);
+        SelectIndexes(Base, Nth + 1, Last, IndexMiddle + 1, IndexLast);
+    }
+
+    /// @internal
+    /// @brief Work out every number in some results from one pass over the timings and a selection.
+    /// @details This sets Iterations to the count of timings, so batched results still need to scale it.
+    /// @param Results The results to fill out, everything but the timings it keeps and the wall time is replaced.
+    /// @param Working The timings, these are reordered unless they are already sorted.
+    /// @param AlreadySorted True if Working is sorted, so nothing needs selecting.
+    void SummarizeTimings(Mezzanine::Testing::MicroBenchmarkResults& Results,
+                          Mezzanine::Testing::MicroBenchmarkResults::TimingLists& Working,
+                          const Mezzanine::Boole AlreadySorted)
+    {
+        using Mezzanine::PreciseReal;
+        using TimeType = Mezzanine::Testing::MicroBenchmarkResults::TimeType;
+
+        Results.Iterations = Working.size();
+        Results.Total = Results.Average = Results.Fastest = Results.Slowest = Results.Median = TimeType{0};
+        Results.FasterThan99Percent = Results.FasterThan90Percent = TimeType{0};
+        Results.FasterThan10Percent = Results.FasterThan1Percent = TimeType{0};
+        Results.RelativeStandardError = 0.0;
+        // No need to process nothing
+        if(Working.empty())
+            { return; }
+
+        // The total and the standard error both come from this one pass.
+        PreciseReal SumOfSquares{0.0};
+        for(const TimeType OneTiming : Working)
+        {
+            Results.Total += OneTiming;
+            const PreciseReal Real{ static_cast<PreciseReal>(OneTiming.count()) };
+            SumOfSquares += Real * Real;
+        }
+        Results.Average = Results.Total / Results.Iterations;
+
+        const PreciseReal Count{ static_cast<PreciseReal>(Working.size()) };
+        const PreciseReal Mean{ static_cast<PreciseReal>(Results.Total.count()) / Count };
+        if(1 < Working.size() && 0.0 < Mean)
+        {
+            // Rounding can push this a hair under zero when every timing is the same.
+            const PreciseReal Variance{ (SumOfSquares - Count * Mean * Mean) / (Count - 1.0) };
+            Results.RelativeStandardError = 0.0 < Variance ? std::sqrt(Variance) / (Mean * std::sqrt(Count)) : 0.0;
+        }
+
+        Mezzanine::SizeType Indexes[std::extent<decltype(FixedPercents)>::value];
+        std::transform(std::begin(FixedPercents), std::end(FixedPercents), std::begin(Indexes),
+                       [&Working](const PreciseReal Percent) { return IndexOfPercent(Working.size(), Percent); });
+        if(!AlreadySorted)
+        {
+            const Mezzanine::SizeType* UniqueEnd{ std::unique(std::begin(Indexes), std::end(Indexes)) };
+            SelectIndexes(Working.begin(), Working.begin(), Working.end(), std::begin(Indexes), UniqueEnd);
+        }
+
+        Results.Fastest = Working[IndexOfPercent(Working.size(), 0.0)];
+        Results.FasterThan99Percent = Working[IndexOfPercent(Working.size(), 0.01)];
+        Results.FasterThan90Percent = Working[IndexOfPercent(Working.size(), 0.10)];
+        Results.Median = Working[IndexOfPercent(Working.size(), 0.5)];
+        Results.FasterThan10Percent = Working[IndexOfPercent(Working.size(), 0.90)];
+        Results.FasterThan1Percent = Working[IndexOfPercent(Working.size(), 0.99)];
+        Results.Slowest = Working[IndexOfPercent(Working.size(), 1.0)];
+    }
+
+    /// @internal
+    /// @brief Keep the timings the results asked for and work out every number from them.
+    /// @param Results The results to fill out, their Retention says what to keep.
+    /// @param Timings The timings, moved from.
+    void KeepAndSummarize(Mezzanine::Testing::MicroBenchmarkResults& Results,
+                          Mezzanine::Testing::MicroBenchmarkResults::TimingLists&& Timings)
+    {
+        using Mezzanine::Testing::TimingRetention;
+        switch(Results.Retention)
+        {
+            case TimingRetention::None:
+                SummarizeTimings(Results, Timings, false);
+                break;
+            case TimingRetention::Unsorted:
+            {
+                // Selecting reorders the timings, so it works in a copy that is freed once the numbers are out.
+                Mezzanine::Testing::MicroBenchmarkResults::TimingLists Working{ Timings };
+                Results.UnsortOriginalTimings = std::move(Timings);
+                SummarizeTimings(Results, Working, false);
+                break;
+            }
+            case TimingRetention::Sorted:
+                Results.SortedTimings = Timings;
+                std::sort(Results.SortedTimings.begin(), Results.SortedTimings.end());
+                Results.UnsortOriginalTimings = std::move(Timings);
+                SummarizeTimings(Results, Results.SortedTimings, true);
+                break;
+        }
+    }
 }
 
 namespace Mezzanine
@@ -105,76 +305,206 @@ namespace Mezzanine
             return PrettyTimeAssembler.str();
         }
 
-        MicroBenchmarkResults::MicroBenchmarkResults(const TimingLists& Timings,
-                                                     const TimeType& PrecalculatedTotal)
-            : SortedTimings(Timings),
-              UnsortOriginalTimings(Timings)
+        TimerCalibration CalibrateTimer()
         {
-            // No need to process nothing
-            if(SortedTimings.size() == 0)
-                { return; }
+            MicroBenchmarkResults::TimingLists Samples;
+            Samples.reserve(CalibrationSampleCount);
+
+            // Timed exactly like the MicroBenchmark loops, but with nothing between the reads.
+            for(SizeType Counter{0}; Counter < CalibrationWarmupCount + CalibrationSampleCount; Counter++)
+            {
+                const std::chrono::high_resolution_clock::time_point Begin{std::chrono::high_resolution_clock::now()};
+                const std::chrono::high_resolution_clock::time_point Current{std::chrono::high_resolution_clock::now()};
+                if(CalibrationWarmupCount <= Counter)
+                    { Samples.push_back(duration_cast<nanoseconds>(Current - Begin)); }
+            }
+
+            const MicroBenchmarkResults Empty{std::move(Samples), nanoseconds{0}, TimingRetention::None};
+            TimerCalibration Results;
+            Results.Overhead = Empty.Median;
+            Results.Uncertainty = Empty.FasterThan10Percent - Empty.FasterThan90Percent;
+            Results.Resolution = MeasureClockResolution();
+            return Results;
+        }
 
-            // Sorting saves us a bunch of effort
-            std::sort(SortedTimings.begin(), SortedTimings.end());
+        const TimerCalibration& GetTimerCalibration()
+        {
+            static const TimerCalibration ProcessCalibration{CalibrateTimer()};
+            return ProcessCalibration;
+        }
 
-            Total = std::accumulate(SortedTimings.begin(), SortedTimings.end(), TimeType{0});
-            WallTotal = PrecalculatedTotal;
+        Boole TimingsAreStable(const MicroBenchmarkResults::TimingLists& Earlier,
+                               const MicroBenchmarkResults::TimingLists& Later,
+                               const PreciseReal Tolerance)
+        {
+            if(Earlier.empty() || Later.empty())
+                { return false; }
+
+            const PreciseReal EarlierMedian{ static_cast<PreciseReal>(MedianOf(Earlier).count()) };
+            const PreciseReal LaterMedian{ static_cast<PreciseReal>(MedianOf(Later).count()) };
+            const PreciseReal Larger{ std::max(EarlierMedian, LaterMedian) };
+            // Two windows of nothing but zeroes are as stable as timings get.
+            return 0.0 == Larger || std::abs(EarlierMedian - LaterMedian) <= Larger * Tolerance;
+        }
 
-            Iterations = SortedTimings.size();
-            Average = Total / Iterations;
+        MicroBenchmarkResults::CountType AutoIterationCount(const MicroBenchmarkResults::TimingLists& Pilot,
+                                                            const PreciseReal TargetRelativeError,
+                                                            const std::chrono::nanoseconds& Budget)
+        {
+            using CountType = MicroBenchmarkResults::CountType;
+            const std::pair<PreciseReal, PreciseReal> Stats{ MeanAndDeviationOf(Pilot) };
+            const PreciseReal Mean{ Stats.first };
+            const PreciseReal Deviation{ Stats.second };
+
+            // The standard error is Deviation / sqrt(N), so solve Deviation / (Mean * sqrt(N)) <= Target for N.
+            PreciseReal Wanted{ static_cast<PreciseReal>(MaximumAutoIterations) };
+            if(0.0 < Mean && 0.0 < TargetRelativeError)
+            {
+                const PreciseReal Ratio{ Deviation / (Mean * TargetRelativeError) };
+                Wanted = std::min(Wanted, std::ceil(Ratio * Ratio));
+            }
+            if(0.0 < Mean)
+                { Wanted = std::min(Wanted, static_cast<PreciseReal>(Budget.count()) / Mean); }
+
+            const CountType Iterations{ static_cast<CountType>(Wanted) };
+            return std::max(MinimumAutoIterations, std::min(MaximumAutoIterations, Iterations));
+        }
 
-            Fastest = SortedTimings.front();
-            FasterThan99Percent = GetIndexValueFromPercent(0.01);
-            FasterThan90Percent = GetIndexValueFromPercent(0.10);
-            Median = GetIndexValueFromPercent(0.5);
-            FasterThan10Percent = GetIndexValueFromPercent(0.90);
-            FasterThan1Percent = GetIndexValueFromPercent(0.99);
-            Slowest = SortedTimings.back();
+        MicroBenchmarkResults::MicroBenchmarkResults(TimingLists Timings,
+                                                     const TimeType& PrecalculatedTotal,
+                                                     const TimingRetention Keep)
+        {
+            WallTotal = PrecalculatedTotal;
+            Retention = Keep;
+            KeepAndSummarize(*this, std::move(Timings));
         }
 
-        MicroBenchmarkResults MicroBenchmarkResults::CopyWithoutZeroes() const
+        MicroBenchmarkResults::MicroBenchmarkResults(TimingLists Timings,
+                                                     const TimeType& PrecalculatedTotal,
+                                                     const TimerCalibration& TimerOverhead,
+                                                     const CountType BatchCalls,
+                                                     const TimingRetention Keep)
         {
-            auto NotZero = [](const TimeType& time){ return time.count() != 0; };
+            Calibration = TimerOverhead;
+            BatchSize = BatchCalls;
+            WallTotal = PrecalculatedTotal;
+            Retention = Keep;
+
+            // Split each batch between its calls in place, but keep the exact total of whole batches.
+            TimeType BatchTotal{0};
+            for(TimeType& OneTiming : Timings)
+            {
+                const TimeType Batch{ TimerOverhead.RemoveOverhead(OneTiming) };
+                BatchTotal += Batch;
+                const CountType Nanoseconds{ static_cast<CountType>(Batch.count()) };
+                OneTiming = TimeType{ static_cast<TimeType::rep>((Nanoseconds + BatchSize / 2) / BatchSize) };
+            }
+            KeepAndSummarize(*this, std::move(Timings));
+            if(1 == BatchSize || 0 == Iterations)
+                { return; }
 
-            SizeType NonZeroCount{static_cast<SizeType>(
-                std::distance(  std::find_if(SortedTimings.begin(), SortedTimings.end(), NotZero),
-                                SortedTimings.end())
-            )};
+            // Each timing counted once above, but stands for a whole batch of calls.
+            Iterations *= BatchSize;
+            Total = BatchTotal;
+            Average = Total / Iterations;
+        }
 
-            TimingLists ZeroFreeUnsortedRecord(NonZeroCount);
+        HistogramBenchmarkResults::HistogramBenchmarkResults(LatencyHistogram Timings,
+                                                             const TimeType& PrecalculatedTotal,
+                                                             const TimerCalibration& TimerOverhead)
+            : Calibration(TimerOverhead),
+              Histogram(std::move(Timings)),
+              Iterations(Histogram.GetCount()),
+              Total(Histogram.GetTotal()),
+              WallTotal(PrecalculatedTotal)
+        {
+            // No need to process nothing
+            if(0 == Iterations)
+                { return; }
 
-            std::copy_if(UnsortOriginalTimings.begin(),
-                         UnsortOriginalTimings.end(),
-                         ZeroFreeUnsortedRecord.begin(),
-                         NotZero);
+            Average = Total / Iterations;
+            Fastest = Histogram.GetFastest();
+            FasterThan99Percent = Histogram.GetValueAtPercent(0.01);
+            FasterThan90Percent = Histogram.GetValueAtPercent(0.10);
+            Median = Histogram.GetValueAtPercent(0.5);
+            FasterThan10Percent = Histogram.GetValueAtPercent(0.90);
+            FasterThan1Percent = Histogram.GetValueAtPercent(0.99);
+            Slowest = Histogram.GetSlowest();
+
+            const PreciseReal Mean{ static_cast<PreciseReal>(Total.count()) / static_cast<PreciseReal>(Iterations) };
+            if(0.0 < Mean)
+            {
+                RelativeStandardError = Histogram.GetStandardDeviation() /
+                                        (Mean * std::sqrt(static_cast<PreciseReal>(Iterations)));
+            }
+        }
 
-            return MicroBenchmarkResults(ZeroFreeUnsortedRecord, WallTotal);
+        void HistogramBenchmarkResults::Merge(const HistogramBenchmarkResults& Other)
+        {
+            LatencyHistogram Merged{Histogram};
+            Merged.Merge(Other.Histogram);
+            *this = HistogramBenchmarkResults(std::move(Merged), WallTotal + Other.WallTotal, Calibration);
         }
 
-        SAVE_WARNING_STATE
-        SUPPRESS_GCC_WARNING("-Wconversion") // The conversion to int to double and back to int for the index
+        MicroBenchmarkResults MicroBenchmarkResults::CopyWithoutZeroes() const
+        {
+            if(TimingRetention::None == Retention)
+                { throw std::logic_error("Cannot remove zeroes from MicroBenchmarkResults that kept no timings."); }
+
+            auto IsZero = [](const TimeType& time){ return time.count() == 0; };
+            MicroBenchmarkResults ZeroFree(*this);
+            ZeroFree.UnsortOriginalTimings.erase(std::remove_if(ZeroFree.UnsortOriginalTimings.begin(),
+                                                                ZeroFree.UnsortOriginalTimings.end(),
+                                                                IsZero),
+                                                 ZeroFree.UnsortOriginalTimings.end());
+
+            // The overhead was already removed from these and they are already per call, so neither is redone.
+            if(TimingRetention::Sorted == Retention)
+            {
+                // Zeroes are all at the front of sorted timings, so cutting them off leaves the rest sorted.
+                ZeroFree.SortedTimings.erase(ZeroFree.SortedTimings.begin(),
+                                             std::upper_bound(ZeroFree.SortedTimings.begin(),
+                                                              ZeroFree.SortedTimings.end(),
+                                                              TimeType{0}));
+                SummarizeTimings(ZeroFree, ZeroFree.SortedTimings, true);
+            } else {
+                TimingLists Working{ ZeroFree.UnsortOriginalTimings };
+                SummarizeTimings(ZeroFree, Working, false);
+            }
+
+            ZeroFree.Iterations *= BatchSize;
+            ZeroFree.Total *= static_cast<TimeType::rep>(BatchSize);
+            if(0 != ZeroFree.Iterations)
+                { ZeroFree.Average = ZeroFree.Total / ZeroFree.Iterations; }
+            return ZeroFree;
+        }
 
         MicroBenchmarkResults::TimingLists::size_type
         MicroBenchmarkResults::GetIndexFromPercent(PreciseReal Percent) const
         {
-            if(0.0 > Percent)
-                { Percent = 0; }
-            if(1.0 < Percent)
-                { Percent = 1.0; }
-
-            TimingLists::size_type Location{static_cast<TimingLists::size_type>(SortedTimings.size() * (Percent))};
-
-            if(SortedTimings.size() <= Location)
-                { Location = SortedTimings.size()-1; }
-            return Location;
+            // Iterations counts every call, but there is only one timing per batch.
+            const CountType TimingCount{ Iterations / std::max(BatchSize, CountType{1}) };
+            if(0 == TimingCount)
+                { return 0; }
+            return IndexOfPercent(static_cast<SizeType>(TimingCount), Percent);
         }
 
-        RESTORE_WARNING_STATE
-
         MicroBenchmarkResults::TimeType MicroBenchmarkResults::GetIndexValueFromPercent(PreciseReal Percent) const
         {
+            if(TimingRetention::None == Retention)
+                { throw std::logic_error("Cannot look up percentiles in MicroBenchmarkResults that kept no timings."); }
+            if(0 == Iterations)
+                { return TimeType{0}; }
+
             const TimingLists::size_type Location{GetIndexFromPercent(Percent)};
-            return SortedTimings[Location];
+            if(TimingRetention::Sorted == Retention)
+                { return SortedTimings[Location]; }
+
+            // Selecting in a copy leaves this untouched, so several threads can look up percentiles at once.
+            TimingLists Working{ UnsortOriginalTimings };
+            const auto Nth = Working.begin() + static_cast<std::ptrdiff_t>(Location);
+            std::nth_element(Working.begin(), Nth, Working.end());
+            return *Nth;
         }
 
     }// Testing
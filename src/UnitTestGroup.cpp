@@ -45,16 +45,62 @@
 #include "MezzTest.h"
 #include "TimingTools.h"
 
-#include <vector>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 using std::chrono::microseconds;
 
+namespace
+{
+    /// @brief The index of an empty slot in the index of test names.
+    const Mezzanine::SizeType NoTest{ std::numeric_limits<Mezzanine::SizeType>::max() };
+}
+
 namespace Mezzanine
 {
     namespace Testing
     {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Test cases, independent parts of a group that can run on different workers.
+
+        const UnitTestGroup::TestCaseListType& UnitTestGroup::TestCases() const
+        {
+            static const TestCaseListType NoTestCases;
+            return NoTestCases;
+        }
+
+        void UnitTestGroup::RunWithTestCases()
+        {
+            (*this)();
+            // Like the scheduler, no new test case is started once the run is cancelled.
+            for(SizeType CaseIndex = 0; CaseIndex < TestCases().size() && !CancellationRequested(); CaseIndex++)
+            {
+                std::unique_ptr<UnitTestGroup> OneTestCase{ CreateTestCase(CaseIndex) };
+                (*OneTestCase)();
+                AddTestCaseResults(*OneTestCase);
+            }
+        }
+
+        std::unique_ptr<UnitTestGroup> UnitTestGroup::CreateTestCase(const SizeType CaseIndex) const
+        {
+            std::unique_ptr<UnitTestGroup> OneTestCase{ TestCases()[CaseIndex]() };
+            OneTestCase->WatchForFailFast(RunFailFast);
+            if(SuccessDetailsOverridden)
+                { OneTestCase->OverrideSuccessDetails(SuccessDetailsOverride); }
+            return OneTestCase;
+        }
+
+        void UnitTestGroup::AddTestCaseResults(const UnitTestGroup& FinishedCase)
+        {
+            TestLog << FinishedCase.GetTestLog();
+            UnstoredSuccessCount += FinishedCase.GetUnstoredSuccessCount();
+            for(const TestData& OneResult : FinishedCase)
+                { StoreTestResult(TestData(OneResult), false); }
+        }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Policy class methods, Test policy classes will implement these. 90% of tests classes ignore these.
 
         Boole UnitTestGroup::EmitIntermediaryTestResults() const
@@ -69,6 +115,15 @@ namespace Mezzanine
         Boole UnitTestGroup::ShouldRunAutomatically() const
             { return true; }
 
+        Mezzanine::String UnitTestGroup::IncrementalKey() const
+            { return Mezzanine::String(); }
+
+        std::chrono::nanoseconds UnitTestGroup::Timeout() const
+            { return std::chrono::nanoseconds::zero(); }
+
+        Boole UnitTestGroup::KeepSuccessDetails() const
+            { return true; }
+
         //////////////////////////////////////////////////////
         // MetaPolicy methods, don't override these, they use the policy methods.
 
@@ -78,6 +133,24 @@ namespace Mezzanine
         Boole UnitTestGroup::CanBeParallel() const
             { return IsMultiThreadSafe() || IsMultiProcessSafe(); }
 
+        Boole UnitTestGroup::StoresSuccessDetails() const
+            { return SuccessDetailsOverridden ? SuccessDetailsOverride : KeepSuccessDetails(); }
+
+        void UnitTestGroup::OverrideSuccessDetails(const Boole Keep)
+        {
+            SuccessDetailsOverridden = true;
+            SuccessDetailsOverride = Keep;
+        }
+
+        Whole UnitTestGroup::GetUnstoredSuccessCount() const
+            { return UnstoredSuccessCount; }
+
+        void UnitTestGroup::WatchForFailFast(FailFastTrigger* Trigger) noexcept
+            { RunFailFast = Trigger; }
+
+        Boole UnitTestGroup::CancellationRequested() const noexcept
+            { return nullptr != RunFailFast && RunFailFast->IsTripped(); }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Make all UnitTestGroups look like a container of TestDatas
         UnitTestGroup::iterator UnitTestGroup::begin()
@@ -98,24 +171,84 @@ namespace Mezzanine
         UnitTestGroup::const_iterator UnitTestGroup::cend() const
             { return TestDataStorage.cend(); }
         
-        void UnitTestGroup::AddTestResultWithoutName(TestData&& CurrentTest)
+        void UnitTestGroup::StoreTestResult(TestData&& CurrentTest, const Boole EmitResult)
         {
-            std::sort(TestDataStorage.begin(), TestDataStorage.end());
-            if(std::binary_search(TestDataStorage.begin(), TestDataStorage.end(), CurrentTest))
+            if(nullptr != RunFailFast)
+                { RunFailFast->Check(CurrentTest.Results); }
+            if(TestResult::Success == CurrentTest.Results && !StoresSuccessDetails())
             {
-                throw std::runtime_error("Multiple tests have the same name, but cannot: " + CurrentTest.TestName);
-            } else {
-                if(EmitIntermediaryTestResults()) { TestLog << CurrentTest; }
-                TestDataStorage.emplace_back(CurrentTest);
+                UnstoredSuccessCount++;
+                return;
+            }
+            // Only names with the same hash are compared, so the stored results are rarely touched.
+            const std::size_t NameHash{ std::hash<String>()(CurrentTest.TestName) };
+            const SizeType Mask{ TestNameIndex.size() - 1 };
+            for(SizeType Slot = NameHash & Mask; !TestNameIndex.empty(); Slot = (Slot + 1) & Mask)
+            {
+                const TestNameSlot& Indexed = TestNameIndex[Slot];
+                if(NoTest == Indexed.second)
+                    { break; }
+                if(NameHash == Indexed.first && TestDataStorage[Indexed.second].TestName == CurrentTest.TestName)
+                {
+                    throw std::runtime_error("Multiple tests have the same name, but cannot: " +
+                                             CurrentTest.TestName);
+                }
+            }
+            if(EmitResult && EmitIntermediaryTestResults())
+                { TestLog << CurrentTest; }
+            IndexTestName(NameHash, TestDataStorage.size());
+            TestDataStorage.push_back(std::move(CurrentTest));
+        }
+
+        void UnitTestGroup::IndexTestName(const std::size_t NameHash, const SizeType Index)
+        {
+            // Doubling keeps this at most half full so searches stay short, the hashes are kept so growing never
+            // needs to look at the names.
+            if(TestNameIndex.size() <= (TestDataStorage.size() + 1) * 2)
+            {
+                std::vector<TestNameSlot> Grown(std::max<SizeType>(16, TestNameIndex.size() * 2), {0, NoTest});
+                for(const TestNameSlot& Indexed : TestNameIndex)
+                {
+                    if(NoTest == Indexed.second)
+                        { continue; }
+                    SizeType Slot{ Indexed.first & (Grown.size() - 1) };
+                    while(NoTest != Grown[Slot].second)
+                        { Slot = (Slot + 1) & (Grown.size() - 1); }
+                    Grown[Slot] = Indexed;
+                }
+                TestNameIndex.swap(Grown);
             }
+
+            SizeType Slot{ NameHash & (TestNameIndex.size() - 1) };
+            while(NoTest != TestNameIndex[Slot].second)
+                { Slot = (Slot + 1) & (TestNameIndex.size() - 1); }
+            TestNameIndex[Slot] = {NameHash, Index};
         }
 
+        void UnitTestGroup::AddTestResultWithoutName(TestData&& CurrentTest)
+            { StoreTestResult(std::move(CurrentTest), true); }
+
         void UnitTestGroup::AddTestResult(TestData&& CurrentTest)
         {
-            CurrentTest.TestName = Name() + "::" + CurrentTest.TestName;
+            CurrentTest.TestName.insert(0, GetTestNamePrefix());
             AddTestResultWithoutName(std::move(CurrentTest));
         }
 
+        const String& UnitTestGroup::GetTestNamePrefix()
+        {
+            if(TestNamePrefix.empty())
+                { TestNamePrefix = Name() + "::"; }
+            return TestNamePrefix;
+        }
+
+        UnitTestGroup::TestDataStorageType UnitTestGroup::TakeTestResults()
+        {
+            TestDataStorageType Taken;
+            Taken.swap(TestDataStorage);
+            TestNameIndex.clear();
+            return Taken;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Other useful stuff.
 
@@ -127,11 +260,11 @@ namespace Mezzanine
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Test Macro Functions Backing
-        TestResult UnitTestGroup::Test(const String& TestName, bool TestCondition,
+        TestResult UnitTestGroup::Test(const StringView TestName, bool TestCondition,
                                  TestResult IfFalse,
                                  TestResult IfTrue,
-                                 const String& FuncName,
-                                 const String& File,
+                                 const StringView FuncName,
+                                 const StringView File,
                                  Whole Line )
         {
             TestResult Result;
@@ -141,14 +274,25 @@ namespace Mezzanine
             }else{
                 Result = IfFalse;
             }
-            AddTestResult( TestData(TestName, Result, FuncName, File, Line) );
+            // Counting a success needs no TestData at all, so skip making one. Otherwise the full name is built in
+            // place once, rather than copying the name and then prepending the group name.
+            if(TestResult::Success == Result && !StoresSuccessDetails())
+            {
+                UnstoredSuccessCount++;
+            } else {
+                const String& Prefix = GetTestNamePrefix();
+                String FullName;
+                FullName.reserve(Prefix.size() + TestName.size());
+                FullName.append(Prefix).append(TestName.data(), TestName.size());
+                AddTestResultWithoutName( TestData(std::move(FullName), Result, FuncName, File, Line) );
+            }
             return Result;
         }
 
-        void UnitTestGroup::TestNoThrow(const String& TestName,
+        void UnitTestGroup::TestNoThrow(const StringView TestName,
                                         std::function<void ()> TestCallable,
                                         TestResult IfFalse, TestResult IfTrue,
-                                        const String& FuncName, const String& File, Whole Line)
+                                        const StringView FuncName, const StringView File, Whole Line)
         {
             Boole Passed{false};
             try
@@ -166,12 +310,12 @@ namespace Mezzanine
             Test(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line);
         }
 
-        void UnitTestGroup::TestTimed(const String& TestName,
+        void UnitTestGroup::TestTimed(const StringView TestName,
                                       std::chrono::microseconds Expected,
                                       std::chrono::microseconds MaxVariance,
                                       std::function<void ()> TestCallable,
                                       TestResult IfFalse, TestResult IfTrue,
-                                      const String& FuncName, const String& File, Whole Line)
+                                      const StringView FuncName, const StringView File, Whole Line)
         {
            TestTimer TestDuration;
            TestCallable();
@@ -186,11 +330,11 @@ namespace Mezzanine
            }
         }
 
-        void UnitTestGroup::TestTimedUnder(const String& TestName,
+        void UnitTestGroup::TestTimedUnder(const StringView TestName,
                                            std::chrono::microseconds MaxAcceptable,
                                            std::function<void ()> TestCallable,
                                            TestResult IfFalse, TestResult IfTrue,
-                                           const String& FuncName, const String& File, Whole Line)
+                                           const StringView FuncName, const StringView File, Whole Line)
         {
            TestTimer TestDuration;
            TestCallable();
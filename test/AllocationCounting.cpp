@@ -0,0 +1,75 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief Global allocation functions that count heap allocations, compiled only into the test executable.
+/// @details Replacing operator new affects the whole program it is linked into, so this lives in its own source file
+/// that only the test target builds and never in a header or the library.
+
+#include "DataTypes.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    /// @brief How many times operator new was called on this thread.
+    /// @details Other threads, like the one passing results to reporters, allocate whenever they like so each thread
+    /// keeps its own count.
+    thread_local Mezzanine::UInt64 AllocationsOnThisThread{ 0 };
+}
+
+Mezzanine::UInt64 AllocationsMadeOnThisThread()
+    { return AllocationsOnThisThread; }
+
+// Array and aligned forms are left alone, the default array forms call these.
+void* operator new(std::size_t Size)
+{
+    ++AllocationsOnThisThread;
+    if(void* Allocated = std::malloc(Size == 0 ? 1 : Size))
+        { return Allocated; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* Freed) noexcept
+    { std::free(Freed); }
+
+void operator delete(void* Freed, std::size_t) noexcept
+    { std::free(Freed); }
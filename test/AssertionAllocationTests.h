@@ -0,0 +1,88 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_AssertionAllocationTests_h
+#define Mezz_Test_AssertionAllocationTests_h
+
+/// @file
+/// @brief A check that passing assertions which are only counted never allocate.
+
+#include "MezzTest.h"
+#include "TestResultInsertionTests.h"
+
+/// @brief How many times operator new was called on the calling thread.
+/// @details Defined in AllocationCounting.cpp, along with the operator new that counts.
+/// @return The number of allocations this thread has made since it started.
+Mezzanine::UInt64 AllocationsMadeOnThisThread();
+
+/// @brief Make sure counted passing assertions do not touch the heap, and that stored ones can be seen doing so.
+AUTOMATIC_TEST_GROUP(AssertionAllocationTests, AssertionAllocation)
+{
+    using Mezzanine::SizeType;
+    using Mezzanine::UInt64;
+    using Mezzanine::Testing::TestResult;
+
+    const SizeType AssertionCount{ 1000 };
+    const std::vector<Mezzanine::String> Names{ MakeResultNames(AssertionCount) };
+
+    // Counting must not allocate at all, not even temporaries that are freed again. The group is warmed up with one
+    // counted assertion first so only the assertions themselves are counted.
+    ResultTargetTests Counted;
+    Counted.OverrideSuccessDetails(false);
+    Counted.Test("Warmup", true, TestResult::Failed, TestResult::Success, __func__, __FILE__, __LINE__);
+    const UInt64 CountedAllocationsBefore{ AllocationsMadeOnThisThread() };
+    for(SizeType Index = 0; Index < AssertionCount; Index++)
+    {
+        Counted.Test("APassingAssertionWithALongEnoughNameToAllocate", true,
+                     TestResult::Failed, TestResult::Success, __func__, __FILE__, __LINE__);
+    }
+    const UInt64 CountedAllocations{ AllocationsMadeOnThisThread() - CountedAllocationsBefore };
+    TEST_EQUAL("CountedNeverAllocate", UInt64{0}, CountedAllocations)
+    TEST_EQUAL("AllCounted", Mezzanine::Whole{AssertionCount + 1}, Counted.GetUnstoredSuccessCount())
+    TEST_EQUAL("NothingStored", SizeType{0}, Counted.TakeTestResults().capacity())
+
+    // Make sure the count can see allocations, otherwise the checks above would pass without checking anything.
+    ResultTargetTests Stored;
+    const UInt64 StoredAllocationsBefore{ AllocationsMadeOnThisThread() };
+    for(const Mezzanine::String& OneName : Names)
+        { Stored.Test(OneName, true, TestResult::Failed, TestResult::Success, __func__, __FILE__, __LINE__); }
+    TEST("StoredAllocationsSeen", AllocationsMadeOnThisThread() - StoredAllocationsBefore >= AssertionCount)
+}
+
+#endif
@@ -0,0 +1,111 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_AssertionCostTests_h
+#define Mezz_Test_AssertionCostTests_h
+
+/// @file
+/// @brief A micro-benchmark of how long one passing assertion takes, stored or only counted.
+
+#include "MezzTest.h"
+#include "TestResultInsertionTests.h"
+
+#include <vector>
+
+/// @brief Time passing assertions before and after successes could be counted instead of stored.
+/// @details AssertionAllocationTests checks that counted ones do not touch the heap on every run.
+BENCHMARK_TEST_GROUP(AssertionCostTests, AssertionCost)
+{
+    using Mezzanine::String;
+    using Mezzanine::SizeType;
+    using Mezzanine::Testing::MicroBenchmarkResults;
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+
+    const SizeType AssertionCount{ 1000 };
+    const Mezzanine::UInt32 Samples{ 100 };
+    // Stored successes need a unique name each, these are made before timing starts.
+    const std::vector<String> Names{ MakeResultNames(AssertionCount) };
+
+    // Before successes could be counted every passing assertion was stored, and its name was joined to the group
+    // name and its function and file were copied into strings of their own on the way.
+    auto StoredLikeBefore = [&Names](ResultTargetTests& Target)
+    {
+        for(const String& OneName : Names)
+        {
+            TestData Stored(Target.Name() + "::" + OneName, TestResult::Success,
+                            String(__func__), String(__FILE__), __LINE__);
+            Target.AddTestResultWithoutName(std::move(Stored));
+        }
+    };
+    // Counted successes can all share a literal name, like assertions in a loop. This calls Test as TEST does.
+    auto CountedNow = [AssertionCount](ResultTargetTests& Target)
+    {
+        Target.OverrideSuccessDetails(false);
+        for(SizeType Index = 0; Index < AssertionCount; Index++)
+        {
+            Target.Test("APassingAssertionWithALongEnoughNameToAllocate", true,
+                        TestResult::Failed, TestResult::Success, __func__, __FILE__, __LINE__);
+        }
+    };
+    // Successes stored now, for comparison in the log.
+    auto StoredNow = [&Names](ResultTargetTests& Target)
+    {
+        for(const String& OneName : Names)
+            { Target.Test(OneName, true, TestResult::Failed, TestResult::Success, __func__, __FILE__, __LINE__); }
+    };
+
+    // Each of these takes a while, so a cancelled run does not wait for the rest.
+    const MicroBenchmarkResults BeforeBench{ BenchmarkRecordingResults(Samples, StoredLikeBefore) };
+    if(CancellationRequested())
+        { return; }
+    const MicroBenchmarkResults StoredBench{ BenchmarkRecordingResults(Samples, StoredNow) };
+    if(CancellationRequested())
+        { return; }
+    const MicroBenchmarkResults CountedBench{ BenchmarkRecordingResults(Samples, CountedNow) };
+
+    auto PerAssertion = [AssertionCount](const MicroBenchmarkResults::TimeType Taken)
+        { return static_cast<double>(Taken.count()) / static_cast<double>(AssertionCount); };
+    TestLog << "Median nanoseconds per passing assertion, stored before counting existed: "
+            << PerAssertion(BeforeBench.Median) << ", stored now: " << PerAssertion(StoredBench.Median)
+            << ", counted: " << PerAssertion(CountedBench.Median) << '\n';
+    TEST_PERF("CountingIsCheaperThanBefore", CountedBench.FasterThan10Percent < BeforeBench.FasterThan90Percent)
+}
+
+#endif
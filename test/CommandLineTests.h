@@ -0,0 +1,405 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CommandLineTests_h
+#define Mezz_Test_CommandLineTests_h
+
+/// @file
+/// @brief Tests for interpreting the command line of the test executable and the tools that act on it.
+
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using Mezzanine::String;
+using Mezzanine::Whole;
+using Mezzanine::SizeType;
+using Mezzanine::Testing::AllLower;
+using Mezzanine::Testing::CoreTestGroup;
+using Mezzanine::Testing::ParsedCommandLineArgs;
+using Mezzanine::Testing::TestResult;
+
+/// @brief Parse a pretend command line the same way the main function would.
+/// @param Args Every argument including the name of the executable.
+/// @param TestGroups The test groups that the arguments can name.
+/// @return Whatever DealWithdCommandLineArgs made of the arguments.
+ParsedCommandLineArgs ParseFakeCommandLine(std::vector<String> Args, const CoreTestGroup& TestGroups)
+{
+    std::vector<char*> ArgPointers;
+    for(String& OneArg : Args)
+        { ArgPointers.push_back(&OneArg[0]); }
+
+    // Bad arguments print the usage, which is just noise here.
+    Mezzanine::Testing::OutputBufferGuard CerrGuard(std::cerr);
+    return Mezzanine::Testing::DealWithdCommandLineArgs(static_cast<int>(ArgPointers.size()),
+                                                        ArgPointers.data(),
+                                                        TestGroups);
+}
+
+/// @brief Create test groups from the registry for a pretend command line the same way the main function would.
+/// @param Args Every argument including the name of the executable.
+/// @param TestGroups Test groups that already exist.
+/// @param CreatedGroups Keeps the test groups that were created.
+/// @return Whatever CreateSelectedTestGroups made of the arguments.
+CoreTestGroup CreateFromFakeCommandLine(std::vector<String> Args,
+                                        const CoreTestGroup& TestGroups,
+                                        std::vector<std::unique_ptr<Mezzanine::Testing::UnitTestGroup>>& CreatedGroups)
+{
+    std::vector<char*> ArgPointers;
+    for(String& OneArg : Args)
+        { ArgPointers.push_back(&OneArg[0]); }
+    return Mezzanine::Testing::CreateSelectedTestGroups(static_cast<int>(ArgPointers.size()),
+                                                        ArgPointers.data(),
+                                                        TestGroups,
+                                                        CreatedGroups);
+}
+
+/// @brief Tests for command line handling and the tools that depend on it.
+AUTOMATIC_TEST_GROUP(CommandLineTests, CommandLine)
+{
+    using Mezzanine::Testing::GetAvailableConcurrency;
+    using Mezzanine::Testing::RunOnWorkerPool;
+
+    CoreTestGroup FakeTestGroup;
+    CommandLineTests CommandLineInstance;
+    FakeTestGroup[AllLower(CommandLineInstance.Name())] = &CommandLineInstance;
+
+    {// Worker Count
+        TEST("AvailableConcurrencyIsPositive", 0 < GetAvailableConcurrency())
+        TEST_EQUAL("WorkerCount-DefaultsToAvailable",
+                   GetAvailableConcurrency(),
+                   ParseFakeCommandLine({"Tester"}, FakeTestGroup).WorkerCount)
+        TEST_EQUAL("WorkerCount-Separate",
+                   Whole{3},
+                   ParseFakeCommandLine({"Tester", "-j", "3"}, FakeTestGroup).WorkerCount)
+        TEST_EQUAL("WorkerCount-Joined",
+                   Whole{5},
+                   ParseFakeCommandLine({"Tester", "-j5"}, FakeTestGroup).WorkerCount)
+        TEST_EQUAL("WorkerCount-ZeroIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "-j", "0"}, FakeTestGroup).ExitWithError)
+        TEST_EQUAL("WorkerCount-MissingIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "-j"}, FakeTestGroup).ExitWithError)
+        TEST_EQUAL("WorkerCount-WordIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "-j", "many"}, FakeTestGroup).ExitWithError)
+    }// Worker Count
+
+    {// Worker Pool
+        const SizeType TaskCount{100};
+        const Whole WorkerCount{4};
+        std::mutex RecordMutex;
+        std::vector<Whole> RunCounts(TaskCount, 0);
+        std::set<Whole> WorkersSeen;
+        RunOnWorkerPool(WorkerCount, TaskCount, [&](Whole WorkerIndex, SizeType TaskIndex)
+        {
+            std::lock_guard<std::mutex> Lock(RecordMutex);
+            RunCounts[TaskIndex]++;
+            WorkersSeen.insert(WorkerIndex);
+        });
+        TEST("WorkerPool-EveryTaskRanOnce",
+             std::all_of(RunCounts.cbegin(), RunCounts.cend(), [](Whole Count){ return 1 == Count; }))
+        TEST("WorkerPool-WorkersBounded", WorkersSeen.size() <= WorkerCount && *WorkersSeen.rbegin() < WorkerCount)
+
+        std::vector<SizeType> InlineOrder;
+        RunOnWorkerPool(1, 3, [&InlineOrder](Whole, SizeType TaskIndex){ InlineOrder.push_back(TaskIndex); });
+        TEST("WorkerPool-SingleWorkerRunsInOrder", (std::vector<SizeType>{0, 1, 2}) == InlineOrder)
+
+        TEST_THROW("WorkerPool-RethrowsTaskFailures", std::runtime_error,
+                   []{ RunOnWorkerPool(2, 4, [](Whole, SizeType){ throw std::runtime_error("Fail"); }); })
+    }// Worker Pool
+
+    {// Output Writer
+        using Mezzanine::Testing::OutputWriter;
+
+        std::stringstream Written;
+        {
+            OutputWriter Writer(Written);
+            RunOnWorkerPool(4, 100, [&Writer](Whole, SizeType TaskIndex)
+                { Writer.Write("<" + std::to_string(TaskIndex) + ">\n"); });
+        }
+        std::vector<String> Lines;
+        for(String OneLine; std::getline(Written, OneLine); )
+            { Lines.push_back(OneLine); }
+        std::sort(Lines.begin(), Lines.end());
+        std::vector<String> Expected;
+        for(SizeType TaskIndex = 0; TaskIndex < 100; TaskIndex++)
+            { Expected.push_back("<" + std::to_string(TaskIndex) + ">"); }
+        std::sort(Expected.begin(), Expected.end());
+        TEST("OutputWriter-EverythingWrittenWhole", Expected == Lines)
+
+        std::stringstream InOrder;
+        {
+            OutputWriter Writer(InOrder);
+            Writer.Write("First ");
+            Writer.Write("Second");
+        }
+        TEST_EQUAL("OutputWriter-KeepsOrder", String("First Second"), InOrder.str())
+    }// Output Writer
+
+    {// Watchdog
+        using Mezzanine::Testing::Watchdog;
+        using std::chrono::milliseconds;
+        using std::chrono::nanoseconds;
+
+        std::atomic<Whole> Expired{0};
+        std::atomic<nanoseconds::rep> ExpiredAfter{0};
+        std::atomic<Whole> Stopped{0};
+        {
+            Watchdog Watcher;
+            const auto CountExpiry = [&Expired, &ExpiredAfter](const nanoseconds Elapsed)
+            {
+                ExpiredAfter = Elapsed.count();
+                Expired++;
+            };
+            Watcher.Start(milliseconds{10}, CountExpiry);
+            Watcher.Stop(Watcher.Start(std::chrono::hours{1}, [&Stopped](nanoseconds){ Stopped++; }));
+            Watcher.Start(nanoseconds::zero(), [&Stopped](nanoseconds){ Stopped++; });
+            for(Whole Waited = 0; 0 == Expired && Waited < 500; Waited++)
+                { std::this_thread::sleep_for(milliseconds{10}); }
+        }
+        TEST_EQUAL("Watchdog-ExpiresOnce", Whole{1}, Expired.load())
+        TEST("Watchdog-ExpiresAfterBudget", milliseconds{10} <= nanoseconds{ExpiredAfter.load()})
+        TEST_EQUAL("Watchdog-StoppedAndUnwatchedNeverExpire", Whole{0}, Stopped.load())
+    }// Watchdog
+
+    {// Timeouts
+        using std::chrono::nanoseconds;
+
+        const auto ParsedTimeout = [&FakeTestGroup](const String& Arg)
+            { return ParseFakeCommandLine({"Tester", Arg}, FakeTestGroup).GroupTimeout.count(); };
+        TEST_EQUAL("Timeout-DefaultsOff",
+                   nanoseconds::rep{0},
+                   ParseFakeCommandLine({"Tester"}, FakeTestGroup).GroupTimeout.count())
+        TEST_EQUAL("Timeout-Seconds", nanoseconds::rep{300000000000}, ParsedTimeout("Timeout=300"))
+        TEST_EQUAL("Timeout-FractionalSeconds", nanoseconds::rep{250000000}, ParsedTimeout("timeout=0.25"))
+        TEST_EQUAL("Timeout-GroupDefaultIsZero", nanoseconds::rep{0}, CommandLineInstance.Timeout().count())
+        for(const String BadTimeout : {"timeout=", "timeout=0", "timeout=-5", "timeout=ten", "timeout=5s"})
+        {
+            TEST_EQUAL("Timeout-BadIsRejected-" + BadTimeout,
+                       EXIT_FAILURE,
+                       ParseFakeCommandLine({"Tester", BadTimeout}, FakeTestGroup).ExitWithError)
+        }
+    }// Timeouts
+
+    {// Fail Fast
+        using Mezzanine::Testing::FailFastTrigger;
+
+        const ParsedCommandLineArgs Defaults{ ParseFakeCommandLine({"Tester"}, FakeTestGroup) };
+        TEST("FailFast-DefaultsOff", !Defaults.FailFast && nullptr == Defaults.CancelTrigger)
+        const ParsedCommandLineArgs Plain{ ParseFakeCommandLine({"Tester", "FailFast"}, FakeTestGroup) };
+        TEST("FailFast-Token", Plain.FailFast && TestResult::Failed == Plain.FailFastSeverity)
+        const ParsedCommandLineArgs AtWarning{ ParseFakeCommandLine({"Tester", "failfast=Warning"}, FakeTestGroup) };
+        TEST("FailFast-Severity", AtWarning.FailFast && TestResult::Warning == AtWarning.FailFastSeverity)
+        TEST_EQUAL("FailFast-BadSeverityIsRejected",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "failfast=badly"}, FakeTestGroup).ExitWithError)
+
+        FailFastTrigger Trigger(TestResult::Warning);
+        TEST("FailFast-StartsClear", !Trigger.IsTripped() && !Trigger.GetTrippedFlag().load())
+        TEST("FailFast-IgnoresMilderResults", !Trigger.Check(TestResult::Cancelled) && !Trigger.IsTripped())
+        TEST("FailFast-TripsAtSeverity", Trigger.Check(TestResult::Warning) && Trigger.GetTrippedFlag().load())
+        TEST("FailFast-StaysTripped", Trigger.Check(TestResult::Success) && Trigger.IsTripped())
+    }// Fail Fast
+
+    {// Failures Only
+        TEST("FailuresOnly-DefaultsOff", !ParseFakeCommandLine({"Tester"}, FakeTestGroup).FailuresOnly)
+        TEST("FailuresOnly-Token", ParseFakeCommandLine({"Tester", "FailuresOnly"}, FakeTestGroup).FailuresOnly)
+    }// Failures Only
+
+    {// Patterns
+        using Mezzanine::Testing::TestGroupMatcher;
+        using Mezzanine::Testing::UnitTestGroup;
+
+        TEST("Glob-Star", TestGroupMatcher::GlobMatches("phys*", "physicsslow"))
+        TEST("Glob-StarMatchesNothing", TestGroupMatcher::GlobMatches("phys*", "phys"))
+        TEST("Glob-Question", TestGroupMatcher::GlobMatches("ph?s", "phys"))
+        TEST("Glob-Inner", TestGroupMatcher::GlobMatches("*ics*low", "physicsslow"))
+        TEST("Glob-Backtracks", TestGroupMatcher::GlobMatches("*slow", "slowslow"))
+        TEST("Glob-WholeText", !TestGroupMatcher::GlobMatches("phys", "physics"))
+        TEST("Glob-Mismatch", !TestGroupMatcher::GlobMatches("*fast", "physicsslow"))
+
+        TestGroupMatcher Matcher;
+        TEST("Matcher-StartsEmpty", Matcher.Empty() && !Matcher.Matches("graphics"))
+        Matcher.AddNameOrGlob("graphics");
+        Matcher.AddNameOrGlob("phys*fast");
+        Matcher.AddRegex("AUDIO[0-9]+");
+        Matcher.AddRegex("net.*");
+        TEST("Matcher-Name", Matcher.Matches("graphics"))
+        TEST("Matcher-Glob", Matcher.Matches("physicsfast"))
+        TEST("Matcher-RegexIgnoresCase", Matcher.Matches("audio12"))
+        TEST("Matcher-SecondRegex", Matcher.Matches("network"))
+        TEST("Matcher-RegexMatchesWhole", !Matcher.Matches("audio12x"))
+        TEST("Matcher-NoMatch", !Matcher.Matches("physicsslow"))
+        TEST_THROW("Matcher-BadRegexThrows", std::regex_error, [&Matcher]{ Matcher.AddRegex("(unclosed"); })
+        TEST("Matcher-BadRegexKeepsOthers", Matcher.Matches("network"))
+
+        CommandLineTests Physics, PhysicsSlow, Graphics;
+        CoreTestGroup PatternGroups;
+        PatternGroups["physics"] = &Physics;
+        PatternGroups["physicsslow"] = &PhysicsSlow;
+        PatternGroups["graphics"] = &Graphics;
+        using GroupList = std::vector<UnitTestGroup*>;
+
+        TEST("Pattern-Glob",
+             (GroupList{&Physics, &PhysicsSlow}) == ParseFakeCommandLine({"Tester", "Phys*"}, PatternGroups).TestsToRun)
+        TEST("Pattern-SkipGlob",
+             (GroupList{&Physics}) == ParseFakeCommandLine({"Tester", "phys*", "skip-*slow"}, PatternGroups).TestsToRun)
+        TEST("Pattern-SkipWinsAnywhere",
+             (GroupList{&Graphics, &Physics}) ==
+             ParseFakeCommandLine({"Tester", "skip-*slow", "All"}, PatternGroups).TestsToRun)
+        TEST("Pattern-SkipAlone",
+             (GroupList{&Graphics, &PhysicsSlow}) ==
+             ParseFakeCommandLine({"Tester", "skip-Physics"}, PatternGroups).TestsToRun)
+        TEST("Pattern-Regex",
+             (GroupList{&Graphics, &PhysicsSlow}) ==
+             ParseFakeCommandLine({"Tester", "regex=(graph|.*slow).*"}, PatternGroups).TestsToRun)
+        TEST("Pattern-SkipRegex",
+             (GroupList{&Graphics}) ==
+             ParseFakeCommandLine({"Tester", "all", "skip-regex=PHYS.*"}, PatternGroups).TestsToRun)
+        TEST("Pattern-NoDuplicates",
+             (GroupList{&Physics, &PhysicsSlow}) ==
+             ParseFakeCommandLine({"Tester", "physics", "phys*"}, PatternGroups).TestsToRun)
+        TEST("Pattern-NoMatchRunsNothing",
+             ParseFakeCommandLine({"Tester", "audio*"}, PatternGroups).TestsToRun.empty())
+        TEST_EQUAL("Pattern-BadRegexIsBad", EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "regex=(unclosed"}, PatternGroups).ExitWithError)
+
+        const String ResponseFileName("CommandLineTestsResponse.txt");
+        {
+            std::ofstream ResponseFile(ResponseFileName);
+            ResponseFile << "# Everything about physics but the slow parts\n"
+                         << "phys*   skip-*slow\n"
+                         << "-j 2 # Trailing comments are ignored too\n";
+        }
+        const ParsedCommandLineArgs FromFile{ ParseFakeCommandLine({"Tester", "@" + ResponseFileName}, PatternGroups) };
+        std::remove(ResponseFileName.c_str());
+        TEST("ResponseFile-Selects", (GroupList{&Physics}) == FromFile.TestsToRun)
+        TEST_EQUAL("ResponseFile-OtherArgs", Whole{2}, FromFile.WorkerCount)
+        TEST_EQUAL("ResponseFile-MissingIsBad", EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "@NoSuchResponseFile.txt"}, PatternGroups).ExitWithError)
+    }// Patterns
+
+    {// Lazy Creation
+        using Mezzanine::Testing::RegisteredTestGroups;
+        using Mezzanine::Testing::UnitTestGroup;
+        const CoreTestGroup NoTestGroups;
+        const SizeType RegisteredCount{ RegisteredTestGroups().size() };
+        TEST("LazyCreation-SelfRegistered", 0 != RegisteredTestGroups().count("commandline"))
+
+        std::vector<std::unique_ptr<UnitTestGroup>> OneCreated;
+        const CoreTestGroup OneGroup{ CreateFromFakeCommandLine({"Tester", "CommandLine", "-j", "2"},
+                                                                NoTestGroups, OneCreated) };
+        TEST_EQUAL("LazyCreation-OnlyNamedCreated", SizeType{1}, OneCreated.size())
+        TEST("LazyCreation-OnlyNamedSelectable", 1 == OneGroup.size() && 0 != OneGroup.count("commandline"))
+        TEST_EQUAL("LazyCreation-CreatedGroupName", String("CommandLine"), OneGroup.at("commandline")->Name())
+
+        std::vector<std::unique_ptr<UnitTestGroup>> AllCreated;
+        TEST_EQUAL("LazyCreation-AllCreatesEvery", RegisteredCount,
+                   CreateFromFakeCommandLine({"Tester", "CommandLine", "All"}, NoTestGroups, AllCreated).size())
+        std::vector<std::unique_ptr<UnitTestGroup>> DefaultCreated;
+        TEST_EQUAL("LazyCreation-NoNamesCreatesEvery", RegisteredCount,
+                   CreateFromFakeCommandLine({"Tester"}, NoTestGroups, DefaultCreated).size())
+        std::vector<std::unique_ptr<UnitTestGroup>> SkipCreated;
+        TEST_EQUAL("LazyCreation-SkipOnlyCreatesEvery", RegisteredCount,
+                   CreateFromFakeCommandLine({"Tester", "skip-CommandLine"}, NoTestGroups, SkipCreated).size())
+
+        std::vector<std::unique_ptr<UnitTestGroup>> NoneCreated;
+        const CoreTestGroup Existing{
+            CreateFromFakeCommandLine({"Tester", "CommandLine"}, FakeTestGroup, NoneCreated) };
+        TEST("LazyCreation-ExistingNotReplaced",
+             NoneCreated.empty() && &CommandLineInstance == Existing.at("commandline"))
+
+        TEST_THROW("LazyCreation-RegisterTwiceThrows", std::invalid_argument,
+                   []{ Mezzanine::Testing::RegisterTestGroup("COMMANDLINE",
+                           []{ return std::unique_ptr<UnitTestGroup>(new CommandLineTests); }); })
+        TEST_THROW("LazyCreation-MismatchedNameThrows", std::logic_error,
+                   []{ Mezzanine::Testing::CreateNamedTestGroup("Physics",
+                           []{ return std::unique_ptr<UnitTestGroup>(new CommandLineTests); }); })
+        TEST_EQUAL("LazyCreation-MatchedNameCreated", String("CommandLine"),
+                   Mezzanine::Testing::CreateNamedTestGroup("COMMANDLINE",
+                       []{ return std::unique_ptr<UnitTestGroup>(new CommandLineTests); })->Name())
+    }// Lazy Creation
+
+    {// Sharding
+        using Mezzanine::Testing::ShardFileName;
+
+        const ParsedCommandLineArgs Unsharded{ ParseFakeCommandLine({"Tester"}, FakeTestGroup) };
+        TEST_EQUAL("Shard-DefaultIndex", Whole{0}, Unsharded.ShardIndex)
+        TEST_EQUAL("Shard-DefaultCount", Whole{1}, Unsharded.ShardCount)
+        TEST_EQUAL("Shard-UnshardedFileName", String("Results.xml"), ShardFileName("Results.xml", Unsharded))
+
+        const ParsedCommandLineArgs Sharded{ ParseFakeCommandLine({"Tester", "Shard=2/3"}, FakeTestGroup) };
+        TEST_EQUAL("Shard-Index", Whole{2}, Sharded.ShardIndex)
+        TEST_EQUAL("Shard-Count", Whole{3}, Sharded.ShardCount)
+        TEST_EQUAL("Shard-FileName", String("Results-shard2of3.xml"), ShardFileName("Results.xml", Sharded))
+        TEST_EQUAL("Shard-FileNameNoExtension", String("Results-shard2of3"), ShardFileName("Results", Sharded))
+        TEST("Shard-NoSharedHistoryByDefault", Sharded.ShardHistoryFileName.empty())
+
+        const ParsedCommandLineArgs WithHistory{
+            ParseFakeCommandLine({"Tester", "Shard=0/2", "ShardHistory=Shared/History.txt"}, FakeTestGroup) };
+        TEST_EQUAL("Shard-SharedHistoryKeepsCase", String("Shared/History.txt"), WithHistory.ShardHistoryFileName)
+        TEST_EQUAL("Shard-SharedHistoryIsNotAShard", Whole{2}, WithHistory.ShardCount)
+
+        TEST_EQUAL("Shard-IndexTooBigIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "shard=3/3"}, FakeTestGroup).ExitWithError)
+        TEST_EQUAL("Shard-ZeroCountIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "shard=0/0"}, FakeTestGroup).ExitWithError)
+        TEST_EQUAL("Shard-NoSlashIsBad",
+                   EXIT_FAILURE,
+                   ParseFakeCommandLine({"Tester", "shard=1"}, FakeTestGroup).ExitWithError)
+    }// Sharding
+}
+
+#endif
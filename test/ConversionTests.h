@@ -55,6 +55,7 @@ SUPPRESS_VC_WARNING(4625) // BS about implicit copy constructors, despite explic
 class ConversionTests : public Mezzanine::Testing::AutomaticTestGroup
 {
     public:
+        static constexpr Mezzanine::StringView RegisteredName = "Conversion";
         virtual ~ConversionTests() override = default;
 
         virtual void operator ()() override;
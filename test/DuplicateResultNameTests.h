@@ -0,0 +1,105 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_DuplicateResultNameTests_h
+#define Mezz_Test_DuplicateResultNameTests_h
+
+/// @file
+/// @brief Tests of the index that finds results recorded twice under the same name.
+
+#include "MezzTest.h"
+#include "TestResultInsertionTests.h"
+
+#include <vector>
+
+/// @brief Make sure a repeated result name is always caught, however full the index of names has become.
+AUTOMATIC_TEST_GROUP(DuplicateResultNameTests, DuplicateResultName)
+{
+    using Mezzanine::SizeType;
+    using Mezzanine::Testing::TestResult;
+
+    // Record a result, returning Success only if it was refused as a repeated name.
+    auto RefusedAsRepeat = [](ResultTargetTests& Target, const Mezzanine::String& Name)
+    {
+        try
+            { Target.Test(Name, true); }
+        catch(const std::runtime_error&)
+            { return TestResult::Success; }
+        return TestResult::Failed;
+    };
+
+    {
+        ResultTargetTests Target;
+        Target.Test("Repeated", true);
+        TEST_RESULT("RepeatedNameStillFails", RefusedAsRepeat(Target, "Repeated"))
+        TEST_EQUAL("RefusedNameNotStored", SizeType{1}, Target.TakeTestResults().size())
+    }
+
+    {
+        // Enough names to grow the index several times over, and to leave plenty of them sharing a first slot so
+        // finding them means walking past others.
+        const SizeType NameCount{ 1000 };
+        const std::vector<Mezzanine::String> Names{ MakeResultNames(NameCount) };
+        ResultTargetTests Target;
+        for(const Mezzanine::String& OneName : Names)
+            { Target.Test(OneName, true); }
+
+        SizeType Refused{ 0 };
+        for(const Mezzanine::String& OneName : Names)
+        {
+            if(TestResult::Success == RefusedAsRepeat(Target, OneName))
+                { Refused++; }
+        }
+        TEST_EQUAL("EveryRepeatFoundAfterGrowing", NameCount, Refused)
+        TEST_RESULT("NewNameAfterGrowingAccepted", RefusedAsRepeat(Target, "NeverRecordedBefore") == TestResult::Failed
+                                                   ? TestResult::Success : TestResult::Failed)
+
+        // Taking the results empties the index too, so the same names can be recorded again.
+        TEST_EQUAL("AllStored", NameCount + 1, Target.TakeTestResults().size())
+        SizeType RefusedAfterTaking{ 0 };
+        for(const Mezzanine::String& OneName : Names)
+        {
+            if(TestResult::Success == RefusedAsRepeat(Target, OneName))
+                { RefusedAfterTaking++; }
+        }
+        TEST_EQUAL("NoneRefusedAfterTaking", SizeType{0}, RefusedAfterTaking)
+    }
+}
+
+#endif
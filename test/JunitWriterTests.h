@@ -0,0 +1,128 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_JunitWriterTests_h
+#define Mezz_Test_JunitWriterTests_h
+
+/// @file
+/// @brief Tests for streaming test results out as Junit XML.
+
+#include "MezzTest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/// @brief Tests that Junit XML is escaped, grouped into suites and written as it is produced.
+AUTOMATIC_TEST_GROUP(JunitWriterTests, JunitWriter)
+{
+    using Mezzanine::String;
+    using Mezzanine::Testing::JunitWriter;
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+
+    {// Group Names
+        TEST_EQUAL("GroupNameOf-Plain", String("Group"), String(JunitWriter::GroupNameOf("Group::Test")))
+        TEST_EQUAL("GroupNameOf-Case", String("Group"), String(JunitWriter::GroupNameOf("Group::Case::Test")))
+        TEST_EQUAL("GroupNameOf-SubProcess",
+                   String("Group"), String(JunitWriter::GroupNameOf("SubProcess::Group::Test")))
+        TEST_EQUAL("GroupNameOf-NoGroup", String("Loose"), String(JunitWriter::GroupNameOf("Loose")))
+    }// Group Names
+
+    {// Writing
+        std::stringstream Xml;
+        {
+            JunitWriter Writer(Xml, 64);
+            Writer.BeginTestSuites(2);
+            TEST("Writer-Buffers", Xml.str().empty())
+            Writer.BeginTestSuite("Group", 2, std::chrono::milliseconds{1500});
+            Writer.AddTestCase(TestData("Group::Fine", TestResult::Success, "Func", "File.h", 1));
+            TEST("Writer-WritesWhenFull", !Xml.str().empty())
+            Writer.AddTestCase(TestData("Group::<Bad & \"Worse\">", TestResult::Failed, "Func", "File.h", 7));
+            Writer.EndTestSuite();
+        }
+        const String Written{ Xml.str() };
+        TEST_STRING_CONTAINS("Writer-SuiteTime", String("<testsuite name=\"Group\" tests=\"2\" time=\"1.500000\">"),
+                             Written)
+        TEST_STRING_CONTAINS("Writer-Success",
+                             String("<testcase classname=\"File.h\" name=\"Group::Fine\" />"), Written)
+        TEST_STRING_CONTAINS("Writer-EscapesNames",
+                             String("name=\"Group::&lt;Bad &amp; &quot;Worse&quot;&gt;\""), Written)
+        TEST_STRING_CONTAINS("Writer-Failure", String("<failure type=\"Failed\">"), Written)
+        TEST_STRING_CONTAINS("Writer-FailureLocation", String("in function 'Func' at File.h:7."), Written)
+        TEST("Writer-FlushesOnDestruction", String::npos != Written.find("</testsuite>"))
+    }// Writing
+
+    {// Emitting
+        const String FileName("JunitWriterTests.xml");
+        const Mezzanine::Testing::UnitTestGroup::TestDataStorageType Results{
+            TestData("GroupA::One"),
+            TestData("GroupA::Two", TestResult::Skipped),
+            TestData("SubProcess::GroupB::One", TestResult::Warning)
+        };
+        const Mezzanine::Testing::UnstoredSuccessCounts Unstored{ {"GroupA", 3}, {"GroupB", 1}, {"GroupC", 2} };
+        const std::vector<Mezzanine::Testing::NamedDuration> Timings{
+            {"GroupA" + Mezzanine::Testing::ParallelTimingSuffix, std::chrono::milliseconds{250}},
+            {"GroupB" + Mezzanine::Testing::SerialTimingSuffix, std::chrono::seconds{2}}
+        };
+        Mezzanine::Testing::EmitJunitResults(Results, FileName, Unstored, Timings);
+
+        std::stringstream Emitted;
+        {
+            std::ifstream XmlFile(FileName);
+            Emitted << XmlFile.rdbuf();
+        }
+        std::remove(FileName.c_str());
+        const String Written{ Emitted.str() };
+        TEST_STRING_CONTAINS("Emit-TotalIncludesUnstored", String("<testsuites tests=\"9\">"), Written)
+        TEST_STRING_CONTAINS("Emit-FirstSuite",
+                             String("<testsuite name=\"GroupA\" tests=\"5\" time=\"0.250000\">"), Written)
+        TEST_STRING_CONTAINS("Emit-SecondSuite",
+                             String("<testsuite name=\"GroupB\" tests=\"2\" time=\"2.000000\">"), Written)
+        TEST_STRING_CONTAINS("Emit-UnstoredOnlySuite",
+                             String("<testsuite name=\"GroupC\" tests=\"2\" time=\"0.000000\">\n    </testsuite>"),
+                             Written)
+        TEST_STRING_CONTAINS("Emit-Skipped", String("<skipped />"), Written)
+        TEST_STRING_CONTAINS("Emit-Ends", String("</testsuites>"), Written)
+    }// Emitting
+}
+
+#endif
@@ -0,0 +1,159 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_LatencyHistogramTests_h
+#define Mezz_Test_LatencyHistogramTests_h
+
+/// @file
+/// @brief Tests for the constant memory histogram of timings and the benchmark results made from it.
+
+#include "MezzTest.h"
+
+#include <chrono>
+#include <stdexcept>
+
+/// @brief Tests for the LatencyHistogram and HistogramBenchmarkResults.
+AUTOMATIC_TEST_GROUP(LatencyHistogramTests, LatencyHistogram)
+{
+    using Mezzanine::Testing::HistogramBenchmarkResults;
+    using Mezzanine::Testing::LatencyHistogram;
+    using Mezzanine::Testing::MicroBenchmarkResults;
+    using std::chrono::nanoseconds;
+
+    {// Layout
+        const LatencyHistogram Default;
+        TEST_EQUAL("DefaultPrecision", Mezzanine::Whole{8}, Default.GetPrecisionBits())
+        TEST_EQUAL("DefaultBucketCount", Mezzanine::SizeType{256 + 56 * 128}, Default.GetBucketCount())
+        TEST_EQUAL("DefaultRelativePrecision", 1.0 / 128.0, Default.GetRelativePrecision())
+        TEST_EQUAL("EmptyPercent", 0, Default.GetValueAtPercent(0.5).count())
+        TEST_THROW("TooLittlePrecisionThrows", std::invalid_argument, []{ LatencyHistogram Coarse(1); })
+        TEST_THROW("TooMuchPrecisionThrows", std::invalid_argument, []{ LatencyHistogram Fine(17); })
+    }// Layout
+
+    {// Recording
+        LatencyHistogram Exact;
+        for(nanoseconds::rep Timing{0}; Timing < 256; Timing++)
+            { Exact.Record(nanoseconds{Timing}); }
+        TEST_EQUAL("SmallCount", LatencyHistogram::CountType{256}, Exact.GetCount())
+        TEST_EQUAL("SmallTotal", 32640, Exact.GetTotal().count())
+        TEST_EQUAL("SmallFastest", 0, Exact.GetFastest().count())
+        TEST_EQUAL("SmallSlowest", 255, Exact.GetSlowest().count())
+        TEST_EQUAL("SmallMedianIsExact", 128, Exact.GetValueAtPercent(0.5).count())
+        TEST_EQUAL("SmallPercentBelowZero", 0, Exact.GetValueAtPercent(-1.0).count())
+        TEST_EQUAL("SmallPercentAboveOne", 255, Exact.GetValueAtPercent(2.0).count())
+
+        LatencyHistogram Large;
+        Large.Record(nanoseconds{1000000}, 3);
+        Large.Record(nanoseconds{3000000});
+        const nanoseconds::rep LargeMedian{ Large.GetValueAtPercent(0.5).count() };
+        TEST_WITHIN_RANGE("LargeWithinPrecision", 1000000, 1000000 + 1000000 / 128, LargeMedian)
+        TEST_EQUAL("LargeSlowestIsExact", 3000000, Large.GetValueAtPercent(1.0).count())
+        TEST_EQUAL("LargeCountedTimes", LatencyHistogram::CountType{4}, Large.GetCount())
+
+        LatencyHistogram Negative;
+        Negative.Record(nanoseconds{-5});
+        TEST_EQUAL("NegativeIsZero", 0, Negative.GetSlowest().count())
+
+        LatencyHistogram Many;
+        for(nanoseconds::rep Timing{0}; Timing < 1000000; Timing++)
+            { Many.Record(nanoseconds{Timing * 997 % 50000000}); }
+        TEST_EQUAL("MemoryIsBounded", LatencyHistogram().GetBucketCount(), Many.GetBucketCount())
+        TEST_EQUAL("ManyCount", LatencyHistogram::CountType{1000000}, Many.GetCount())
+    }// Recording
+
+    {// Merging
+        LatencyHistogram Fast;
+        Fast.Record(nanoseconds{10}, 2);
+        LatencyHistogram Slow;
+        Slow.Record(nanoseconds{90}, 2);
+        Fast.Merge(Slow);
+        TEST_EQUAL("MergeCount", LatencyHistogram::CountType{4}, Fast.GetCount())
+        TEST_EQUAL("MergeFastest", 10, Fast.GetFastest().count())
+        TEST_EQUAL("MergeSlowest", 90, Fast.GetSlowest().count())
+        TEST_EQUAL("MergeMedian", 90, Fast.GetValueAtPercent(0.5).count())
+
+        LatencyHistogram Empty;
+        Empty.Merge(Slow);
+        TEST_EQUAL("MergeIntoEmptyFastest", 90, Empty.GetFastest().count())
+        TEST_THROW("MergeDifferentPrecisionThrows", std::invalid_argument,
+                   [&Slow]{ LatencyHistogram Other(4); Other.Merge(Slow); })
+    }// Merging
+
+    {// Results
+        MicroBenchmarkResults::TimingLists Timings;
+        LatencyHistogram Histogram;
+        for(nanoseconds::rep Timing{1}; Timing <= 200; Timing++)
+        {
+            Timings.push_back(nanoseconds{Timing});
+            Histogram.Record(nanoseconds{Timing});
+        }
+        const MicroBenchmarkResults Sorted(Timings, nanoseconds{50000});
+        const HistogramBenchmarkResults Counted(Histogram, nanoseconds{50000});
+
+        TEST_EQUAL("ResultsIterations", Sorted.Iterations, Counted.Iterations)
+        TEST_EQUAL("ResultsTotal", Sorted.Total.count(), Counted.Total.count())
+        TEST_EQUAL("ResultsAverage", Sorted.Average.count(), Counted.Average.count())
+        TEST_EQUAL("ResultsFastest", Sorted.Fastest.count(), Counted.Fastest.count())
+        TEST_EQUAL("ResultsPercentile1st", Sorted.FasterThan99Percent.count(), Counted.FasterThan99Percent.count())
+        TEST_EQUAL("ResultsPercentile10th", Sorted.FasterThan90Percent.count(), Counted.FasterThan90Percent.count())
+        TEST_EQUAL("ResultsMedian", Sorted.Median.count(), Counted.Median.count())
+        TEST_EQUAL("ResultsPercentile90th", Sorted.FasterThan10Percent.count(), Counted.FasterThan10Percent.count())
+        TEST_EQUAL("ResultsPercentile99th", Sorted.FasterThan1Percent.count(), Counted.FasterThan1Percent.count())
+        TEST_EQUAL("ResultsSlowest", Sorted.Slowest.count(), Counted.Slowest.count())
+        TEST_WITHIN_RANGE("ResultsRelativeStandardError",
+                          Sorted.RelativeStandardError - 0.0001,
+                          Sorted.RelativeStandardError + 0.0001,
+                          Counted.RelativeStandardError)
+
+        HistogramBenchmarkResults Merged(Counted);
+        Merged.Merge(Counted);
+        TEST_EQUAL("ResultsMergeIterations", 2 * Counted.Iterations, Merged.Iterations)
+        TEST_EQUAL("ResultsMergeWallTotal", 100000, Merged.WallTotal.count())
+        TEST_EQUAL("ResultsMergeMedian", Counted.Median.count(), Merged.Median.count())
+
+        const HistogramBenchmarkResults Benchmarked =
+            Mezzanine::Testing::HistogramMicroBenchmark(std::chrono::milliseconds{5}, []{});
+        TEST("BenchmarkTimed", 0 < Benchmarked.Iterations)
+        TEST("BenchmarkOrdered", Benchmarked.Fastest <= Benchmarked.Median &&
+                                 Benchmarked.Median <= Benchmarked.Slowest)
+        TEST("BenchmarkWallTotal", Benchmarked.Total <= Benchmarked.WallTotal)
+    }// Results
+}
+
+#endif
@@ -45,7 +45,12 @@
 
 #include "MezzTest.h"
 
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
 #include <fstream>
+#include <thread>
 
 /// @brief Tests for the class to store test data results.
 BENCHMARK_TEST_GROUP(ProcessTests, Process)
@@ -69,6 +74,10 @@ BENCHMARK_TEST_GROUP(ProcessTests, Process)
                    true,
                    FalseResult.ConsoleOutput.empty())
 
+        TEST_EQUAL("RunCommand(const_StringView)-NoResultChannel",
+                   true,
+                   HelloResult.ResultChannelOutput.empty())
+
         Testing::CommandResult TrueResult = Testing::RunCommand("git --help");
         TEST_EQUAL("RunCommand(const_StringView)-TrueCommand-ExitCode",
                    Integer(0),
@@ -82,9 +91,122 @@ BENCHMARK_TEST_GROUP(ProcessTests, Process)
                    []{ (void)Testing::RunCommand("echo foo | somefile.txt"); })
     }//RunCommand
 
+    {//RunCommandStreaming
+        String Streamed;
+        Whole ChunkCount{0};
+        const Integer StreamedExitCode = Testing::RunCommandStreaming("cmake -E echo Hello",
+            [&Streamed, &ChunkCount](StringView Chunk)
+            {
+                Streamed.append(Chunk.data(), Chunk.size());
+                ChunkCount++;
+            });
+        TEST_EQUAL("RunCommandStreaming-Hello-ExitCode", Integer(0), StreamedExitCode)
+        TEST_STRING_CONTAINS("RunCommandStreaming-Hello-Output", String("Hello"), Streamed)
+        TEST("RunCommandStreaming-Hello-Chunks", 0 < ChunkCount)
+
+        Testing::TestTimer TimeoutTimer;
+        const Integer TimedOutExitCode = Testing::RunCommandStreaming("cmake -E sleep 30",
+                                                                      [](StringView){},
+                                                                      Testing::CommandOutputCallback(),
+                                                                      std::chrono::milliseconds{200});
+        TEST_EQUAL("RunCommandStreaming-Timeout-ExitCode", Testing::TimedOutExitCode, TimedOutExitCode)
+        TEST("RunCommandStreaming-Timeout-Killed", std::chrono::seconds{10} > TimeoutTimer.GetLength())
+
+        Testing::TestTimer CancelTimer;
+        const std::atomic<Boole> Cancel{true};
+        const Integer CancelledExitCode = Testing::RunCommandStreaming("cmake -E sleep 30",
+                                                                       [](StringView){},
+                                                                       Testing::CommandOutputCallback(),
+                                                                       std::chrono::nanoseconds{0},
+                                                                       &Cancel);
+        TEST_EQUAL("RunCommandStreaming-Cancel-ExitCode", Testing::CancelledExitCode, CancelledExitCode)
+        TEST("RunCommandStreaming-Cancel-Killed", std::chrono::seconds{10} > CancelTimer.GetLength())
+    }//RunCommandStreaming
+
     {//RunCommand w/ ExecutablePath
         // No good way to test this.
     }//RunCommand w/ ExecutablePath
+
+    {//ProcessZygote
+        if(Testing::ProcessZygote::IsSupported())
+        {
+            Testing::ProcessZygote Zygote([](StringView JobName) -> Integer
+            {
+                if("crash" == JobName)
+                    { std::abort(); }
+                if("throw" == JobName)
+                    { throw std::runtime_error("Thrown in a job"); }
+                if("chatty" == JobName)
+                {
+                    for(Whole Line = 0; Line < 100000; Line++)
+                        { std::cout << "Some line of chatter that nobody needs to keep\n"; }
+                    return 0;
+                }
+                if("channel" == JobName)
+                    { return Testing::WriteToResultChannel("Sent on the side") ? 0 : 1; }
+                if("hang" == JobName)
+                {
+                    std::cout << "Hanging" << std::endl;
+                    while(true)
+                        { std::this_thread::sleep_for(std::chrono::seconds{1}); }
+                }
+                std::cout << "Job " << JobName << "\n";
+                return static_cast<Integer>(JobName.size());
+            });
+
+            Testing::CommandResult FirstResult = Zygote.RunInChild("First");
+            TEST_EQUAL("ProcessZygote-First-ExitCode", Integer(5), FirstResult.ExitCode)
+            TEST_EQUAL("ProcessZygote-First-Output", String("Job First"), FirstResult.ConsoleOutput)
+
+            Testing::CommandResult SecondResult = Zygote.RunInChild("Second");
+            TEST_EQUAL("ProcessZygote-Second-ExitCode", Integer(6), SecondResult.ExitCode)
+            TEST_EQUAL("ProcessZygote-Second-Output", String("Job Second"), SecondResult.ConsoleOutput)
+
+            Testing::CommandResult CrashResult = Zygote.RunInChild("crash");
+            TEST_EQUAL("ProcessZygote-Crash-ExitCode", Integer(SIGABRT), CrashResult.ExitCode)
+
+            Testing::CommandResult ThrowResult = Zygote.RunInChild("throw");
+            TEST_EQUAL("ProcessZygote-Throw-ExitCode", Integer(EXIT_FAILURE), ThrowResult.ExitCode)
+            TEST_STRING_CONTAINS("ProcessZygote-Throw-Output", String("Thrown in a job"), ThrowResult.ConsoleOutput)
+
+            Testing::CommandResult ChannelResult = Zygote.RunInChild("channel");
+            TEST_EQUAL("ProcessZygote-ResultChannel-ExitCode", Integer(0), ChannelResult.ExitCode)
+            TEST_EQUAL("ProcessZygote-ResultChannel-Output",
+                       String("Sent on the side"),
+                       ChannelResult.ResultChannelOutput)
+            TEST_EQUAL("ProcessZygote-ResultChannel-Console", true, ChannelResult.ConsoleOutput.empty())
+
+            Whole ChattyChunks{0};
+            SizeType ChattyLargestChunk{0};
+            SizeType ChattyTotal{0};
+            const Integer ChattyExitCode = Zygote.RunInChildStreaming("chatty",
+                [&](StringView Chunk)
+                {
+                    ChattyChunks++;
+                    ChattyTotal += Chunk.size();
+                    ChattyLargestChunk = std::max(ChattyLargestChunk, Chunk.size());
+                });
+            TEST_EQUAL("ProcessZygote-Streaming-ExitCode", Integer(0), ChattyExitCode)
+            TEST_EQUAL("ProcessZygote-Streaming-Total", SizeType{4700000}, ChattyTotal)
+            TEST("ProcessZygote-Streaming-ManyChunks", 1 < ChattyChunks)
+            TEST("ProcessZygote-Streaming-SmallChunks", ChattyLargestChunk < ChattyTotal)
+
+            String HangOutput;
+            const Integer HangExitCode = Zygote.RunInChildStreaming("hang",
+                [&HangOutput](StringView Chunk) { HangOutput.append(Chunk.data(), Chunk.size()); },
+                Testing::CommandOutputCallback(),
+                std::chrono::milliseconds{200});
+            TEST_EQUAL("ProcessZygote-Timeout-ExitCode", Testing::TimedOutExitCode, HangExitCode)
+            TEST_STRING_CONTAINS("ProcessZygote-Timeout-OutputKept", String("Hanging"), HangOutput)
+
+            Testing::CommandResult AfterCrashResult = Zygote.RunInChild("Survived");
+            TEST_EQUAL("ProcessZygote-AfterCrash-Output", String("Job Survived"), AfterCrashResult.ConsoleOutput)
+        } else {
+            TEST_THROW("ProcessZygote-Unsupported",
+                       std::runtime_error,
+                       []{ Testing::ProcessZygote Zygote([](StringView) { return Integer(0); }); })
+        }
+    }//ProcessZygote
 }
 
 #endif
@@ -0,0 +1,194 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestCaseTests_h
+#define Mezz_Test_TestCaseTests_h
+
+/// @file
+/// @brief Tests for test cases, the independent parts of a test group declared with TEST_CASE.
+
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+using Mezzanine::String;
+using Mezzanine::SizeType;
+
+// This group is not run directly by the Unit Test framework, TestCaseTests runs it to check that test cases are
+// found, run and merged correctly.
+SILENT_TEST_GROUP(ExampleTestCaseTests, ExampleTestCase)
+{
+    TEST("Body", true)
+}
+
+TEST_CASE(ExampleTestCaseTests, First)
+{
+    TEST("One", true)
+}
+
+TEST_CASE(ExampleTestCaseTests, Second)
+{
+    TEST("One", true)
+    TEST_WARN("Two", false)
+}
+
+namespace
+{
+    /// @brief The fail fast run CancelledTestCaseTests trips part way through, as if another group had failed.
+    Mezzanine::Testing::FailFastTrigger* TripWhileRunning{ nullptr };
+}
+
+// This group is not run directly by the Unit Test framework, TestCaseTests runs it to check that a run cancelled while
+// it is running stops it early and starts none of its test cases.
+BENCHMARK_TEST_GROUP(CancelledTestCaseTests, CancelledTestCase)
+{
+    TEST("BeforeCancel", true)
+    if(nullptr != TripWhileRunning)
+        { TripWhileRunning->Trip(); }
+    if(CancellationRequested())
+        { return; }
+    TEST("AfterCancel", true)
+}
+
+TEST_CASE(CancelledTestCaseTests, NeverStarted)
+{
+    TEST("One", true)
+}
+
+// Like ExampleTestCaseTests but without any test cases.
+SILENT_TEST_GROUP(ExampleNoTestCaseTests, ExampleNoTestCase)
+{
+    TEST("Body", true)
+}
+
+/// @brief Tests for declaring test cases and gathering their results into their group.
+AUTOMATIC_TEST_GROUP(TestCaseTests, TestCase)
+{
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+
+    {// Registration
+        ExampleTestCaseTests Example;
+        TEST_EQUAL("CasesRegistered", SizeType{2}, Example.TestCases().size())
+        TEST_EQUAL("GroupsWithoutCasesHaveNone", SizeType{0}, ExampleNoTestCaseTests{}.TestCases().size())
+
+        std::unique_ptr<Mezzanine::Testing::UnitTestGroup> FirstCase{ Example.TestCases()[0]() };
+        TEST_EQUAL("CaseNamedAfterGroup", String("ExampleTestCase::First"), FirstCase->Name())
+        TEST_EQUAL("CasesHaveNoCases", SizeType{0}, FirstCase->TestCases().size())
+        TEST("CasesKeepGroupPolicies", !FirstCase->EmitIntermediaryTestResults())
+    }// Registration
+
+    {// Running
+        ExampleTestCaseTests Example;
+        Example.RunWithTestCases();
+        std::vector<String> Names;
+        for(const TestData& OneResult : Example)
+            { Names.push_back(OneResult.TestName); }
+        std::sort(Names.begin(), Names.end());
+        TEST("AllResultsGathered", (std::vector<String>{ "ExampleTestCase::Body",
+                                                          "ExampleTestCase::First::One",
+                                                          "ExampleTestCase::Second::One",
+                                                          "ExampleTestCase::Second::Two" }) == Names)
+        TEST_EQUAL("WorstCaseResultKept", TestResult::Warning, Example.GetWorstResults())
+
+        std::unique_ptr<Mezzanine::Testing::UnitTestGroup> RepeatedCase{ Example.TestCases()[0]() };
+        RepeatedCase->operator()();
+        TEST_THROW("RepeatedCaseResultsFail", std::runtime_error,
+                   [&]{ Example.AddTestCaseResults(*RepeatedCase); })
+    }// Running
+
+    {// Success Details
+        ExampleTestCaseTests Example;
+        Example.OverrideSuccessDetails(false);
+        TEST("CasesShareSuccessOverride", !Example.CreateTestCase(0)->StoresSuccessDetails())
+
+        Example.RunWithTestCases();
+        TEST("CaseSuccessesOnlyCounted", 1 == std::distance(Example.begin(), Example.end()) &&
+                                         "ExampleTestCase::Second::Two" == Example.begin()->TestName)
+        TEST_EQUAL("CaseSuccessesCounted", Mezzanine::Whole{3}, Example.GetUnstoredSuccessCount())
+    }// Success Details
+
+    {// Cancellation
+        using Mezzanine::Testing::FailFastTrigger;
+        using Mezzanine::Testing::FinishedTestGroups;
+        using Mezzanine::Testing::NamedDuration;
+        using Mezzanine::Testing::ParsedCommandLineArgs;
+
+        CancelledTestCaseTests Cancelled;
+        TEST("Cancellation-NotRequestedUnwatched", !Cancelled.CancellationRequested())
+
+        // Run it the way the runner runs groups that cannot share the process, in a fail fast run another group
+        // stops while it is running.
+        FailFastTrigger Trigger;
+        ParsedCommandLineArgs Options;
+        Options.TestsToRun = { &Cancelled };
+        Options.DoBenchmark = true;
+        Options.FailFast = true;
+        Options.CancelTrigger = &Trigger;
+        Cancelled.WatchForFailFast(&Trigger);
+        TripWhileRunning = &Trigger;
+        FinishedTestGroups Finished;
+        Mezzanine::Testing::RunSerializedTests(Options, Finished);
+        TripWhileRunning = nullptr;
+
+        TEST("Cancellation-SeenWhileRunning", Cancelled.CancellationRequested())
+        Mezzanine::Testing::UnitTestGroup::TestDataStorageType Results;
+        std::vector<NamedDuration> Timings;
+        Mezzanine::Testing::UnstoredSuccessCounts UnstoredSuccesses;
+        Finished.TakeAll(Results, Timings, UnstoredSuccesses);
+        std::vector<String> Names;
+        for(const TestData& OneResult : Results)
+            { Names.push_back(OneResult.TestName); }
+        std::sort(Names.begin(), Names.end());
+        TEST("Cancellation-ReturnedEarlyWithNoCases",
+             (std::vector<String>{ "CancelledTestCase::BeforeCancel", "CancelledTestCase::Cancelled" }) == Names)
+        TEST_EQUAL("Cancellation-RecordedAsCancelled", TestResult::Cancelled,
+                   Mezzanine::Testing::GetWorstResults(Results))
+    }// Cancellation
+}
+
+TEST_CASE(TestCaseTests, SeparateWorker)
+{
+    // Run by the scheduler itself, separately from the body above, its results still come back under TestCase.
+    TEST("CaseRuns", true)
+}
+
+#endif
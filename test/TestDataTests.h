@@ -75,6 +75,18 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
     TEST_EQUAL("TestDataConstruction.FileName",     String("file.cpp"),     Constructed.FileName)
     TEST_EQUAL("TestDataConstruction.LineNumber",   Mezzanine::Whole{42},   Constructed.LineNumber)
 
+    // Interned source locations
+    using Mezzanine::Testing::InternTestText;
+    const TestData FromTemporaries("Name", TestResult::Failed, String("Temporary") + "Func", String("temp.cpp"), 7);
+    TEST_EQUAL("Intern-OutlivesTemporaries", String("TemporaryFunc"), FromTemporaries.FunctionName)
+    const String FirstCopy("Shared.cpp");
+    const String SecondCopy("Shared.cpp");
+    TEST("Intern-EqualTextShared", InternTestText(FirstCopy).data() == InternTestText(SecondCopy).data())
+    TEST("Intern-NotTheOriginal", InternTestText(FirstCopy).data() != FirstCopy.data())
+    TEST("Intern-ResultsShareLocations",
+         TestData("A", TestResult::Success, "Func", "file.cpp").FileName.data() == Constructed.FileName.data())
+    TEST("Intern-EmptyIsEmpty", InternTestText("").empty())
+
     // Sorting
     std::vector<TestData> Sorted = {TestData("Ocelot"), TestData("Aardvark"), TestData("Zebra")};
     std::sort(Sorted.begin(), Sorted.end());
@@ -235,6 +247,47 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
     TEST_EQUAL("PostCopyTargetDestAssign",  TestData("Source", TestResult::Success),    DestAssign)
     TEST_EQUAL("PostCopyTargetDestMove",    TestData("Source", TestResult::Success),    DestMove)
 
+    // Binary record tests
+    using Mezzanine::Testing::TestDataView;
+    using Mezzanine::Testing::AppendTestDataRecord;
+    using Mezzanine::Testing::ReadTestDataRecord;
+
+    const TestData FirstRecorded("First", TestResult::Failed, "Func", "File.h", 1234567);
+    const TestData SecondRecorded("Second", TestResult::Success);
+    String Records;
+    AppendTestDataRecord(FirstRecorded, Records);
+    const Mezzanine::SizeType FirstRecordSize{ Records.size() };
+    AppendTestDataRecord(SecondRecorded, Records);
+    TEST_EQUAL("Record-Size", Mezzanine::SizeType{21 + 5 + 4 + 6}, FirstRecordSize)
+
+    TestDataView Viewed;
+    Mezzanine::StringView Remaining(Records);
+    const Mezzanine::SizeType FirstReadSize{ ReadTestDataRecord(Remaining, Viewed) };
+    TEST_EQUAL("Record-ReadFirstSize", FirstRecordSize, FirstReadSize)
+    TEST_EQUAL("Record-ReadFirst", FirstRecorded, Viewed.ToTestData())
+    TEST("Record-ReadFirstIsAView", Records.data() < Viewed.TestName.data() &&
+                                    Viewed.FileName.data() < Records.data() + Records.size())
+    Remaining.remove_prefix(FirstReadSize);
+    TEST_EQUAL("Record-ReadSecondSize", Remaining.size(), ReadTestDataRecord(Remaining, Viewed))
+    TEST_EQUAL("Record-ReadSecondWithPrefix",
+               TestData("Sub::Second", TestResult::Success),
+               Viewed.ToTestData("Sub::"))
+
+    const Mezzanine::StringView Partial(Records.data(), FirstRecordSize - 1);
+    TEST_EQUAL("Record-PartialNeedsMore", Mezzanine::SizeType{0}, ReadTestDataRecord(Partial, Viewed))
+    TEST_EQUAL("Record-EmptyNeedsMore", Mezzanine::SizeType{0}, ReadTestDataRecord("", Viewed))
+
+    String BadResult(Records.substr(0, FirstRecordSize));
+    BadResult[4] = static_cast<char>(99);
+    TEST_THROW("Record-BadResultThrows",
+               std::runtime_error,
+               [&BadResult]{ TestDataView Unused; (void)ReadTestDataRecord(BadResult, Unused); })
+    String BadLength(Records.substr(0, FirstRecordSize));
+    BadLength[9] = static_cast<char>(100);
+    TEST_THROW("Record-BadStringLengthThrows",
+               std::runtime_error,
+               [&BadLength]{ TestDataView Unused; (void)ReadTestDataRecord(BadLength, Unused); })
+
     // Add throw tests
 }
 
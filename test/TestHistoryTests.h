@@ -0,0 +1,283 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestHistoryTests_h
+#define Mezz_Test_TestHistoryTests_h
+
+/// @file
+/// @brief Tests for remembering test durations and ordering test groups with them.
+
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+SAVE_WARNING_STATE
+SUPPRESS_VC_WARNING(4625) // BS about implicit copy constructors, despite explicit deletion in parent class.
+SUPPRESS_VC_WARNING(5026) // more BS about move constructors implicitly removed
+SUPPRESS_VC_WARNING(5027) // Why are there garbage warnings like these three even in vs?
+SUPPRESS_CLANG_WARNING("-Wpadded")
+
+// This class is not called directly by the Unit Test framework and is just used by
+/// @brief TestHistoryTests to have groups with names worth sorting.
+class MEZZ_LIB NameOnlyTestGroup : public Mezzanine::Testing::AutomaticTestGroup
+{
+    private:
+        /// @brief What this group is called.
+        Mezzanine::String GroupName;
+
+    public:
+        /// @brief Create a group that does nothing.
+        /// @param NewName What the group should be called.
+        explicit NameOnlyTestGroup(const Mezzanine::String& NewName) : GroupName(NewName)
+            {}
+
+        virtual void operator()() override
+            {}
+        virtual Mezzanine::String Name() const override
+            { return GroupName; }
+};
+
+/// @brief Tests for loading, saving, updating and using the history of test durations and results.
+AUTOMATIC_TEST_GROUP(TestHistoryTests, TestHistory)
+{
+    using Mezzanine::String;
+    using Mezzanine::Testing::NamedDuration;
+    using Mezzanine::Testing::TestDurationHistory;
+    using Mezzanine::Testing::UnitTestGroup;
+    using Mezzanine::Testing::LoadTestHistory;
+    using Mezzanine::Testing::SaveTestHistory;
+    using Mezzanine::Testing::UpdateTestHistory;
+    using Mezzanine::Testing::SortTestsByHistory;
+    using std::chrono::nanoseconds;
+
+    {// Load and Save
+        std::stringstream Mangled("100 Alpha\r\nBeta\nnope Gamma\n-5 Delta\n42 Epsilon Zeta\n\n7 \n");
+        const TestDurationHistory Loaded{ LoadTestHistory(Mangled) };
+        TEST_EQUAL("Load-OnlyGoodLines", TestDurationHistory::size_type{2}, Loaded.size())
+        TEST_EQUAL("Load-TrimsLineEnd", nanoseconds::rep{100}, Loaded.at("Alpha").count())
+        TEST_EQUAL("Load-NamesWithSpaces", nanoseconds::rep{42}, Loaded.at("Epsilon Zeta").count())
+
+        std::stringstream Empty;
+        TEST("Load-EmptyIsEmpty", LoadTestHistory(Empty).empty())
+
+        std::stringstream Saved;
+        SaveTestHistory(Loaded, Saved);
+        TEST_EQUAL("Save-Format", String("100 Alpha\n42 Epsilon Zeta\n"), Saved.str())
+        TEST("Save-RoundTrip", Loaded == LoadTestHistory(Saved))
+    }// Load and Save
+
+    {// Update
+        TestDurationHistory History{ {"Kept", nanoseconds{9}}, {"Replaced", nanoseconds{9}} };
+        const std::vector<NamedDuration> Timings{ {"Initial Setup", nanoseconds{1}},
+                                                  {"Replaced" + Mezzanine::Testing::ParallelTimingSuffix,
+                                                   nanoseconds{2}},
+                                                  {"Serial" + Mezzanine::Testing::SerialTimingSuffix,
+                                                   nanoseconds{3}} };
+        UpdateTestHistory(History, Timings);
+        TEST_EQUAL("Update-Count", TestDurationHistory::size_type{3}, History.size())
+        TEST_EQUAL("Update-KeepsUnrun", nanoseconds::rep{9}, History.at("Kept").count())
+        TEST_EQUAL("Update-ReplacesParallel", nanoseconds::rep{2}, History.at("Replaced").count())
+        TEST_EQUAL("Update-AddsSerial", nanoseconds::rep{3}, History.at("Serial").count())
+    }// Update
+
+    {// Sort
+        NameOnlyTestGroup Short("Short");
+        NameOnlyTestGroup Long("Long");
+        NameOnlyTestGroup NewA("NewA");
+        NameOnlyTestGroup Middle("Middle");
+        NameOnlyTestGroup NewB("NewB");
+        const std::vector<UnitTestGroup*> Original{ &Short, &Long, &NewA, &Middle, &NewB };
+
+        std::vector<UnitTestGroup*> Unsorted{ Original };
+        SortTestsByHistory(Unsorted, TestDurationHistory{});
+        TEST("Sort-NoHistoryKeepsOrder", Original == Unsorted)
+
+        std::vector<UnitTestGroup*> Sorted{ Original };
+        SortTestsByHistory(Sorted, { {"Short", nanoseconds{1}},
+                                     {"Middle", nanoseconds{50}},
+                                     {"Long", nanoseconds{100}},
+                                     {"Unused", nanoseconds{1000}} });
+        const std::vector<UnitTestGroup*> Expected{ &NewA, &NewB, &Long, &Middle, &Short };
+        TEST("Sort-UntimedThenLongestFirst", Expected == Sorted)
+    }// Sort
+
+    {// Shard
+        using Mezzanine::Whole;
+        using Mezzanine::Testing::SelectShard;
+
+        std::deque<NameOnlyTestGroup> Groups; // Test groups cannot be moved, so they cannot go in a vector.
+        std::vector<UnitTestGroup*> AllGroups;
+        for(Whole Count = 0; Count < 20; Count++)
+        {
+            Groups.emplace_back("Group" + std::to_string(Count));
+            AllGroups.push_back(&Groups.back());
+        }
+
+        const auto CheckShards = [&AllGroups](const TestDurationHistory& History, const Whole ShardCount)
+        {
+            std::vector<Whole> TimesSelected(AllGroups.size(), 0);
+            for(Whole ShardIndex = 0; ShardIndex < ShardCount; ShardIndex++)
+            {
+                std::vector<UnitTestGroup*> Shard{ AllGroups };
+                SelectShard(Shard, ShardIndex, ShardCount, History);
+                std::vector<UnitTestGroup*> Again{ AllGroups };
+                SelectShard(Again, ShardIndex, ShardCount, History);
+                if(Shard != Again)
+                    { return false; }
+                for(UnitTestGroup* OneGroup : Shard)
+                {
+                    const auto Position = std::find(AllGroups.cbegin(), AllGroups.cend(), OneGroup);
+                    TimesSelected[static_cast<Whole>(Position - AllGroups.cbegin())]++;
+                }
+            }
+            return std::all_of(TimesSelected.cbegin(), TimesSelected.cend(), [](Whole Times){ return 1 == Times; });
+        };
+        TEST("Shard-ByHashEachGroupOnce", CheckShards(TestDurationHistory{}, 3))
+
+        TestDurationHistory Balanced;
+        for(Whole Count = 0; Count < 10; Count++)
+            { Balanced["Group" + std::to_string(Count)] = nanoseconds{100 * (Count + 1)}; }
+        TEST("Shard-ByHistoryEachGroupOnce", CheckShards(Balanced, 3))
+        TEST("Shard-OneShardKeepsAll", CheckShards(Balanced, 1))
+
+        // 1000, 900 ... 100 over two shards is dealt out to exactly 2700 and 2800.
+        nanoseconds::rep FirstShardTime{0};
+        std::vector<UnitTestGroup*> First{ AllGroups.begin(), AllGroups.begin() + 10 };
+        SelectShard(First, 0, 2, Balanced);
+        for(UnitTestGroup* OneGroup : First)
+            { FirstShardTime += Balanced.at(OneGroup->Name()).count(); }
+        TEST("Shard-ByHistoryBalanced", 2700 == FirstShardTime || 2800 == FirstShardTime)
+    }// Shard
+
+    {// Incremental
+        using Mezzanine::UInt64;
+        using Mezzanine::Testing::TestData;
+        using Mezzanine::Testing::TestResult;
+        using Mezzanine::Testing::IncrementalHistory;
+        using Mezzanine::Testing::IncrementalKeyOf;
+        using Mezzanine::Testing::LoadIncrementalHistory;
+        using Mezzanine::Testing::SaveIncrementalHistory;
+        using Mezzanine::Testing::SkipUnchangedTests;
+        using Mezzanine::Testing::UpdateIncrementalHistory;
+
+        TEST_EQUAL("Incremental-UnreadableFileHashesToZero",
+                   UInt64{0}, Mezzanine::Testing::HashFileContents("No/Such/Incremental/File"))
+        const Mezzanine::String RunningExecutable{ Mezzanine::Testing::GetExecutablePath() };
+        TEST("Incremental-RunningExecutableFound", !RunningExecutable.empty())
+        TEST("Incremental-RunningExecutableHashed",
+             UInt64{0} != Mezzanine::Testing::HashFileContents(RunningExecutable))
+
+        std::stringstream Mangled("ff 0 Alpha\r\nnope 0 Beta\n10 x Gamma\n1a 7 Delta Epsilon\n\n");
+        const IncrementalHistory Loaded{ LoadIncrementalHistory(Mangled) };
+        TEST_EQUAL("Incremental-LoadOnlyGoodLines", IncrementalHistory::size_type{2}, Loaded.size())
+        TEST_EQUAL("Incremental-LoadKey", UInt64{0xff}, Loaded.at("Alpha").Key)
+        TEST_EQUAL("Incremental-LoadNamesWithSpaces", UInt64{0x1a}, Loaded.at("Delta Epsilon").Key)
+        std::stringstream Saved;
+        SaveIncrementalHistory(Loaded, Saved);
+        const IncrementalHistory Reloaded{ LoadIncrementalHistory(Saved) };
+        TEST("Incremental-RoundTrip", Reloaded.size() == Loaded.size() &&
+                                      std::equal(Loaded.cbegin(), Loaded.cend(), Reloaded.cbegin(),
+                                                 [](const auto& Left, const auto& Right)
+                                                 {
+                                                     return Left.first == Right.first &&
+                                                            Left.second.Key == Right.second.Key &&
+                                                            Left.second.Worst == Right.second.Worst;
+                                                 }))
+
+        NameOnlyTestGroup Passed("Passed");
+        NameOnlyTestGroup Failed("Failed");
+        NameOnlyTestGroup Fresh("Fresh");
+        const UInt64 ExecutableHash{12345};
+        const std::vector<UnitTestGroup*> Original{ &Passed, &Failed, &Fresh };
+        const UnitTestGroup::TestDataStorageType FirstResults{
+            TestData("Passed::One", TestResult::Success),
+            TestData("SubProcess::Failed::One", TestResult::Success),
+            TestData("SubProcess::Failed::Two", TestResult::Failed) };
+
+        IncrementalHistory History;
+        UpdateIncrementalHistory(History, { &Passed, &Failed }, FirstResults, ExecutableHash);
+        TEST_EQUAL("Incremental-UpdateCount", IncrementalHistory::size_type{2}, History.size())
+        TEST_EQUAL("Incremental-UpdateWorst", TestResult::Failed, History.at("Failed").Worst)
+        TEST_EQUAL("Incremental-UpdateKey", IncrementalKeyOf(Passed, ExecutableHash), History.at("Passed").Key)
+
+        std::vector<UnitTestGroup*> Same{ Original };
+        const UnitTestGroup::TestDataStorageType Hits{ SkipUnchangedTests(Same, History, ExecutableHash) };
+        const std::vector<UnitTestGroup*> Rerun{ &Failed, &Fresh };
+        TEST("Incremental-SkipsOnlyUnchangedPasses", Rerun == Same)
+        TEST("Incremental-OneSkippedResultPerHit", 1 == Hits.size() &&
+                                                   "Passed::CacheHit" == Hits.front().TestName &&
+                                                   TestResult::Skipped == Hits.front().Results)
+
+        std::vector<UnitTestGroup*> Rebuilt{ Original };
+        TEST("Incremental-NewExecutableRunsAll", SkipUnchangedTests(Rebuilt, History, 54321).empty() &&
+                                                 Original == Rebuilt)
+        std::vector<UnitTestGroup*> Unreadable{ Original };
+        TEST("Incremental-UnreadableExecutableRunsAll", SkipUnchangedTests(Unreadable, History, 0).empty() &&
+                                                        Original == Unreadable)
+
+        UpdateIncrementalHistory(History, { &Failed, &Fresh }, { TestData("Failed::Two", TestResult::Success) },
+                                 ExecutableHash);
+        TEST_EQUAL("Incremental-UpdateFixed", TestResult::Success, History.at("Failed").Worst)
+        TEST("Incremental-UpdateKeepsUnrun", 0 == History.count("Fresh") && 1 == History.count("Passed"))
+
+        UpdateIncrementalHistory(History, { &Passed }, { TestData("Passed::Cancelled", TestResult::Cancelled) },
+                                 ExecutableHash);
+        TEST("Incremental-UpdateForgetsCancelled", 0 == History.count("Passed") && 1 == History.count("Failed"))
+
+        // Cancelled is not the worst result, a slow test before the cut must not make the group look finished.
+        UpdateIncrementalHistory(History, { &Passed, &Failed }, FirstResults, ExecutableHash);
+        UpdateIncrementalHistory(History, { &Passed, &Failed },
+                                 { TestData("Passed::Slow", TestResult::NonPerformant),
+                                   TestData("Passed::Cancelled", TestResult::Cancelled),
+                                   TestData("Failed::One", TestResult::NonPerformant),
+                                   TestData("Failed::Timeout", TestResult::Unknown) },
+                                 ExecutableHash);
+        TEST("Incremental-UpdateForgetsCancelledNonPerformant", 0 == History.count("Passed"))
+        TEST("Incremental-UpdateForgetsTimedOut", 0 == History.count("Failed"))
+    }// Incremental
+}
+
+RESTORE_WARNING_STATE
+
+#endif
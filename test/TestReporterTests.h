@@ -0,0 +1,182 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestReporterTests_h
+#define Mezz_Test_TestReporterTests_h
+
+/// @file
+/// @brief Tests for the reporters that stream results out as test groups finish.
+
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+/// @brief A reporter that only remembers what it was told, to check what is passed along.
+class CountingReporter : public Mezzanine::Testing::TestReporter
+{
+    public:
+        /// @brief How many times BeginRun was called.
+        Mezzanine::Whole Begun = 0;
+        /// @brief How many results were passed to ReportResults in total.
+        Mezzanine::Whole Reported = 0;
+        /// @brief How many times EndRun was called.
+        Mezzanine::Whole Ended = 0;
+        /// @brief The thread results were last reported from.
+        std::thread::id ReportingThread;
+
+        /// @brief Count the call.
+        virtual void BeginRun() override
+            { Begun++; }
+        /// @brief Count the results.
+        /// @param First The first result of the group.
+        /// @param Last One past the last result of the group.
+        virtual void ReportResults(ResultIterator First, ResultIterator Last) override
+        {
+            Reported += static_cast<Mezzanine::Whole>(Last - First);
+            ReportingThread = std::this_thread::get_id();
+        }
+        /// @brief Count the call.
+        virtual void EndRun(const Mezzanine::Whole) override
+            { Ended++; }
+};
+
+/// @brief A reporter that cannot finish ending the run until it is let go, like one writing to a full disk.
+class StuckReporter : public Mezzanine::Testing::TestReporter
+{
+    public:
+        /// @brief Set this to let EndRun return.
+        std::promise<void> Release;
+
+        /// @brief Ignore the results.
+        virtual void ReportResults(ResultIterator, ResultIterator) override
+            {}
+        /// @brief Wait until released.
+        virtual void EndRun(const Mezzanine::Whole) override
+            { Release.get_future().wait(); }
+};
+
+/// @brief Tests the JSON Lines and TAP output and the list that passes results to many reporters.
+AUTOMATIC_TEST_GROUP(TestReporterTests, TestReporter)
+{
+    using Mezzanine::String;
+    using Mezzanine::Whole;
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+
+    const Mezzanine::Testing::UnitTestGroup::TestDataStorageType Results{
+        TestData("Group::Fine", TestResult::Success, "Func", "File.h", 3),
+        TestData("Group::Quoted \"#1\"\n", TestResult::Failed, "Func", "Isn't.h", 7),
+        TestData("Group::Later", TestResult::Skipped, "Func", "File.h", 9)
+    };
+
+    {// JSON Lines
+        std::stringstream Json;
+        Mezzanine::Testing::JsonLinesReporter Reporter(Json);
+        Reporter.BeginRun();
+        Reporter.ReportResults(Results.cbegin(), Results.cend());
+        Reporter.EndRun(5);
+        const String Written{ Json.str() };
+
+        TEST_STRING_CONTAINS("JsonLines-Result",
+                             String("{\"event\":\"result\",\"name\":\"Group::Fine\",\"result\":\"Success\","
+                                    "\"function\":\"Func\",\"file\":\"File.h\",\"line\":3}\n"), Written)
+        TEST_STRING_CONTAINS("JsonLines-Escapes", String("\"name\":\"Group::Quoted \\\"#1\\\"\\n\""), Written)
+        TEST_STRING_CONTAINS("JsonLines-End", String("{\"event\":\"end\",\"unstored_successes\":5}\n"), Written)
+        TEST_EQUAL("JsonLines-OneLineEach", std::ptrdiff_t{4}, std::count(Written.cbegin(), Written.cend(), '\n'))
+    }// JSON Lines
+
+    {// TAP
+        std::stringstream Tap;
+        Mezzanine::Testing::TapReporter Reporter(Tap);
+        Reporter.BeginRun();
+        Reporter.ReportResults(Results.cbegin(), Results.cbegin() + 1);
+        Reporter.ReportResults(Results.cbegin() + 1, Results.cend());
+        Reporter.EndRun(2);
+        const String Written{ Tap.str() };
+
+        TEST_EQUAL("Tap-Version", 0u, Written.find("TAP version 13\n"))
+        TEST_STRING_CONTAINS("Tap-Ok", String("ok 1 - Group::Fine\n"), Written)
+        TEST_STRING_CONTAINS("Tap-NotOk", String("not ok 2 - Group::Quoted \"\\#1\" \n"), Written)
+        TEST_STRING_CONTAINS("Tap-Diagnostics", String("  result: Failed\n  function: 'Func'\n  file: 'Isn''t.h'\n"),
+                             Written)
+        TEST_STRING_CONTAINS("Tap-Skip", String("ok 3 - Group::Later # SKIP\n"), Written)
+        TEST_STRING_CONTAINS("Tap-Unstored", String("# 2 more successes"), Written)
+        TEST("Tap-PlanLast", Written.size() >= 5 && 0 == Written.compare(Written.size() - 5, 5, "1..3\n"))
+    }// TAP
+
+    {// Reporter List
+        Mezzanine::Testing::TestReporterList Reporters;
+        TEST("List-StartsEmpty", Reporters.Empty())
+        std::unique_ptr<CountingReporter> First{ new CountingReporter };
+        std::unique_ptr<CountingReporter> Second{ new CountingReporter };
+        CountingReporter& FirstRef = *First;
+        CountingReporter& SecondRef = *Second;
+        Reporters.Add(std::move(First));
+        Reporters.Add(std::move(Second));
+
+        Reporters.BeginRun();
+        Mezzanine::Testing::RunOnWorkerPool(4, 20, [&](Whole, Mezzanine::SizeType)
+            { Reporters.ReportResults(Results.cbegin(), Results.cend()); });
+        Reporters.EndRun(0);
+        TEST("List-PassesToAll", 1 == FirstRef.Begun && 1 == SecondRef.Begun &&
+                                 1 == FirstRef.Ended && 1 == SecondRef.Ended)
+        TEST_EQUAL("List-EveryResultFromEveryThread", Whole{60}, FirstRef.Reported)
+        TEST_EQUAL("List-SameForEachReporter", FirstRef.Reported, SecondRef.Reported)
+        TEST("List-ReportsOffTheCallingThread", std::this_thread::get_id() != FirstRef.ReportingThread)
+    }// Reporter List
+
+    {// Abandoned Run
+        Mezzanine::Testing::TestReporterList Reporters;
+        std::unique_ptr<StuckReporter> Stuck{ new StuckReporter };
+        StuckReporter& StuckRef = *Stuck;
+        Reporters.Add(std::move(Stuck));
+
+        Reporters.BeginRun();
+        TEST("List-EndRunWithinGivesUp", !Reporters.EndRunWithin(0, std::chrono::milliseconds{50}))
+        StuckRef.Release.set_value();
+        TEST("List-EndRunWithinStillPassedOn", Reporters.WaitUntilReported(std::chrono::seconds{30}))
+    }// Abandoned Run
+}
+
+#endif
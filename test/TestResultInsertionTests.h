@@ -0,0 +1,132 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestResultInsertionTests_h
+#define Mezz_Test_TestResultInsertionTests_h
+
+/// @file
+/// @brief A benchmark of how the cost of recording a test result grows with the number already recorded.
+
+#include "MezzTest.h"
+
+#include <cmath>
+#include <vector>
+
+// This group is not run directly by the Unit Test framework. TestResultInsertionTests and the other groups that include
+// this header record results in instances of it.
+SILENT_TEST_GROUP(ResultTargetTests, ResultTarget)
+{
+}
+
+/// @brief Time recording results into fresh ResultTargetTests groups.
+/// @details Each timing covers creating one group, recording into it and destroying it, so freeing what the results
+/// allocated counts too.
+/// @tparam RecordType A callable accepting a ResultTargetTests& to record results into.
+/// @param Samples How many groups to fill, each gets its own timing.
+/// @param Record Called once with each fresh group.
+/// @return The timings of every group.
+template<typename RecordType>
+Mezzanine::Testing::MicroBenchmarkResults BenchmarkRecordingResults(const Mezzanine::UInt32 Samples,
+                                                                    RecordType&& Record)
+{
+    return Mezzanine::Testing::MicroBenchmark(Samples, [&Record]
+        {
+            ResultTargetTests Target;
+            Record(Target);
+        });
+}
+
+/// @brief Make the unique result names a benchmark records, before any timing starts.
+/// @param Count How many names to make.
+/// @return Count distinct names long enough that copying them allocates.
+inline std::vector<Mezzanine::String> MakeResultNames(const Mezzanine::SizeType Count)
+{
+    std::vector<Mezzanine::String> Names;
+    Names.reserve(Count);
+    for(Mezzanine::SizeType Index = 0; Index < Count; Index++)
+        { Names.push_back("APassingAssertionWithAName" + std::to_string(Index)); }
+    return Names;
+}
+
+/// @brief Time recording many results into a group and make sure each one costs about the same no matter how many
+/// came before it.
+BENCHMARK_TEST_GROUP(TestResultInsertionTests, TestResultInsertion)
+{
+    using Mezzanine::String;
+    using Mezzanine::SizeType;
+    using Mezzanine::Testing::MicroBenchmarkResults;
+
+    const SizeType SmallCount{ 1000 };
+    const SizeType LargeCount{ SmallCount * 16 };
+    const std::vector<String> Names{ MakeResultNames(LargeCount) };
+
+    // Fill each group with the first Count names, so small and large groups record identical results.
+    auto FillWith = [&Names](const SizeType Count)
+    {
+        return [&Names, Count](ResultTargetTests& Target)
+        {
+            for(SizeType Index = 0; Index < Count; Index++)
+                { Target.Test(Names[Index], true); }
+        };
+    };
+    const MicroBenchmarkResults SmallBench{ BenchmarkRecordingResults(100, FillWith(SmallCount)) };
+    if(CancellationRequested())
+        { return; }
+    const MicroBenchmarkResults LargeBench{ BenchmarkRecordingResults(25, FillWith(LargeCount)) };
+
+    // Percentiles are of whole groups, these turn them into nanoseconds per result.
+    auto PerResult = [](const MicroBenchmarkResults::TimeType Taken, const SizeType Count)
+        { return static_cast<double>(Taken.count()) / static_cast<double>(Count); };
+    const double SmallSlowEnd{ PerResult(SmallBench.FasterThan10Percent, SmallCount) };
+    const double LargeFastEnd{ PerResult(LargeBench.FasterThan90Percent, LargeCount) };
+    const double LargeSlowEnd{ PerResult(LargeBench.FasterThan10Percent, LargeCount) };
+    const double SmallFastEnd{ PerResult(SmallBench.FasterThan90Percent, SmallCount) };
+    TestLog << "Nanoseconds per result, 10th to 90th percentile, " << SmallCount << " results: " << SmallFastEnd
+            << " to " << SmallSlowEnd << ", " << LargeCount << " results: " << LargeFastEnd << " to "
+            << LargeSlowEnd << '\n';
+
+    // With a linear search per result each one in the large group would cost 16 times as much, with constant cost
+    // they would match. Allow growth up to halfway between those on a log scale, sqrt(16) or 4 times, to leave room
+    // for cache effects. This compares the slow end of the large group, its 90th percentile, against the fast end
+    // of the small group, its 10th percentile, so one lucky run of the large group cannot pass it.
+    const double LinearGrowth{ static_cast<double>(LargeCount) / static_cast<double>(SmallCount) };
+    TEST_PERF("CostPerResultIsConstant", LargeSlowEnd < SmallFastEnd * std::sqrt(LinearGrowth))
+}
+
+#endif
@@ -0,0 +1,163 @@
+// © Copyright 2010 - 2020 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestResultLogTests_h
+#define Mezz_Test_TestResultLogTests_h
+
+/// @file
+/// @brief Tests for the log of results appended to TestResults.txt as test groups finish.
+
+#include "MezzTest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+/// @brief Tests that each group is in the log once reported and that the index finds it.
+AUTOMATIC_TEST_GROUP(TestResultLogTests, TestResultLog)
+{
+    using Mezzanine::String;
+    using Mezzanine::UInt64;
+    using Mezzanine::Testing::ReadTestResultLogIndex;
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+    using Mezzanine::Testing::TestResultLog;
+    using Mezzanine::Testing::TestResultLogIndexEntry;
+
+    const Mezzanine::Testing::UnitTestGroup::TestDataStorageType Results{
+        TestData("First::One", TestResult::Success, "Func", "File.h", 3),
+        TestData("First::Two", TestResult::Failed, "Func", "File.h", 4),
+        TestData("SubProcess::Second::One", TestResult::Success, "Func", "File.h", 5)
+    };
+
+    // Read all of a file.
+    const auto ReadFile = [](const String& FileName)
+    {
+        std::ifstream File(FileName, std::ios::binary);
+        std::stringstream Contents;
+        Contents << File.rdbuf();
+        return Contents.str();
+    };
+
+    {// Finished Run
+        const String FileName("TestResultLogTests-Finished.txt");
+        {
+            TestResultLog Log(FileName);
+            TEST("Log-Opens", Log.IsOpen())
+            Log.ReportResults(Results.cbegin(), Results.cbegin() + 2);
+            TEST_STRING_CONTAINS("Log-WrittenAsReported", String("First::Two"), ReadFile(FileName))
+            Log.ReportResults(Results.cbegin() + 2, Results.cend());
+            Log.EndRun(0);
+        }
+
+        const String Contents{ ReadFile(FileName) };
+        std::ifstream File(FileName, std::ios::binary);
+        const std::vector<TestResultLogIndexEntry> Index{ ReadTestResultLogIndex(File) };
+        std::remove(FileName.c_str());
+
+        TEST_EQUAL("Index-EveryGroup", Mezzanine::SizeType{2}, Index.size())
+        if(2 == Index.size())
+        {
+            TEST_EQUAL("Index-FirstName", String("First"), Index[0].GroupName)
+            TEST_EQUAL("Index-SecondName", String("Second"), Index[1].GroupName)
+            TEST_EQUAL("Index-FirstOffset", UInt64{0}, Index[0].Offset)
+            TEST_EQUAL("Index-Contiguous", Index[0].Length, Index[1].Offset)
+
+            std::stringstream FirstGroup;
+            FirstGroup << Results[0] << Results[1];
+            TEST_EQUAL("Index-FindsGroup", FirstGroup.str(), Contents.substr(Index[0].Offset, Index[0].Length))
+            TEST_STRING_CONTAINS("Index-FindsSubProcessGroup", String("SubProcess::Second::One"),
+                                 Contents.substr(Index[1].Offset, Index[1].Length))
+        }
+    }// Finished Run
+
+    {// Cache Hits
+        const String FileName("TestResultLogTests-CacheHits.txt");
+        const Mezzanine::Testing::UnitTestGroup::TestDataStorageType CacheHits{
+            TestData("Alpha::" + Mezzanine::Testing::CacheHitTestName, TestResult::Skipped),
+            TestData("Beta::" + Mezzanine::Testing::CacheHitTestName, TestResult::Skipped),
+            TestData("Gamma::" + Mezzanine::Testing::CacheHitTestName, TestResult::Skipped)
+        };
+        {
+            TestResultLog Log(FileName);
+            Mezzanine::Testing::ReportCacheHits(Log, CacheHits);
+            Log.EndRun(0);
+        }
+
+        const String Contents{ ReadFile(FileName) };
+        std::ifstream File(FileName, std::ios::binary);
+        const std::vector<TestResultLogIndexEntry> Index{ ReadTestResultLogIndex(File) };
+        std::remove(FileName.c_str());
+
+        TEST_EQUAL("CacheHits-EachIndexed", Mezzanine::SizeType{3}, Index.size())
+        if(3 == Index.size())
+        {
+            TEST("CacheHits-IndexNames", "Alpha" == Index[0].GroupName && "Beta" == Index[1].GroupName &&
+                                         "Gamma" == Index[2].GroupName)
+            std::stringstream LastHit;
+            LastHit << CacheHits[2];
+            TEST_EQUAL("CacheHits-IndexFindsOnlyItsGroup", LastHit.str(),
+                       Contents.substr(Index[2].Offset, Index[2].Length))
+        }
+    }// Cache Hits
+
+    {// Interrupted Run
+        const String FileName("TestResultLogTests-Interrupted.txt");
+        {
+            TestResultLog Log(FileName);
+            Log.ReportResults(Results.cbegin(), Results.cend());
+        }// Never ended, like a run that was killed.
+
+        const String Contents{ ReadFile(FileName) };
+        std::ifstream File(FileName, std::ios::binary);
+        TEST("Interrupted-NoIndex", ReadTestResultLogIndex(File).empty())
+        std::remove(FileName.c_str());
+        TEST_STRING_CONTAINS("Interrupted-KeepsResults", String("SubProcess::Second::One"), Contents)
+    }// Interrupted Run
+
+    {// Bad Files
+        std::istringstream Empty;
+        TEST("Read-EmptyHasNoIndex", ReadTestResultLogIndex(Empty).empty())
+        std::istringstream Mangled("Something\n--= Index At 999 =--\n");
+        TEST("Read-MangledHasNoIndex", ReadTestResultLogIndex(Mangled).empty())
+    }// Bad Files
+}
+
+#endif
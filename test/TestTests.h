@@ -45,6 +45,8 @@
 
 #include "MezzTest.h"
 
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 
@@ -109,10 +111,37 @@ void WarningTestTests::operator ()()
     TEST_RESULT("TestResultWarning", Mezzanine::Testing::TestResult::Warning)
 }
 
+// This class is not called directly by the Unit Test framework and is just used by
+/// @brief TestTests to verify that successes can be counted instead of stored.
+class MEZZ_LIB FailuresOnlyTestTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        virtual void operator()() override;
+        virtual Mezzanine::String Name() const override
+            { return "FailuresOnlyTests"; }
+
+        /// @brief Don't print the Failure that is supposed to happen.
+        virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+            { return false; }
+
+        /// @brief Only count successes.
+        virtual Mezzanine::Boole KeepSuccessDetails() const override
+            { return false; }
+};
+
+void FailuresOnlyTestTests::operator ()()
+{
+    TEST("FirstPassing", true)
+    TEST_EQUAL("SecondPassing", 1, 1)
+    TEST("Failing", false)
+    TEST("FirstPassing", true) // Counted successes are not checked for repeated names.
+}
+
 /// @brief This is the actual Test class. This tests our Test Macros.
 class MEZZ_LIB TestTests : public Mezzanine::Testing::AutomaticTestGroup
 {
     public:
+        static constexpr Mezzanine::StringView RegisteredName = "Tests";
         virtual void operator()() override;
         virtual Mezzanine::String Name() const override
             { return "Tests"; }
@@ -135,15 +164,18 @@ void TestTests::operator ()()
     TEST_STRING_CONTAINS("TestStringContains", Mezzanine::String("Foo"), Mezzanine::String("Foobar"))
 
     // AddTestResult is the function that runs all these test macros. This should verify that calling those
-    // macros twice with the same name fails
+    // macros twice with the same name fails. A separate group that keeps every success is used, because the
+    // failuresonly token would stop this one from checking the names of successes.
+    class WarningTestTests Duplicated;
+    Duplicated.OverrideSuccessDetails(true);
     TEST_THROW("TwoIdenticalTestNamesFail", std::runtime_error,
-        [this]{
-            AddTestResult( Mezzanine::Testing::TestData( ("TwoIdenticalTestNamesFailImpl"),
-                                                         (Mezzanine::Testing::TestResult::Success),
-                                                         "RunAutomaticTests", __FILE__, __LINE__));
-            AddTestResult( Mezzanine::Testing::TestData( ("TwoIdenticalTestNamesFailImpl"),
-                                                         (Mezzanine::Testing::TestResult::Success),
-                                                         "RunAutomaticTests", __FILE__, __LINE__));
+        [&Duplicated]{
+            Duplicated.AddTestResult( Mezzanine::Testing::TestData( ("TwoIdenticalTestNamesFailImpl"),
+                                                                    (Mezzanine::Testing::TestResult::Success),
+                                                                    "RunAutomaticTests", __FILE__, __LINE__));
+            Duplicated.AddTestResult( Mezzanine::Testing::TestData( ("TwoIdenticalTestNamesFailImpl"),
+                                                                    (Mezzanine::Testing::TestResult::Success),
+                                                                    "RunAutomaticTests", __FILE__, __LINE__));
         }
     )
 
@@ -161,6 +193,24 @@ void TestTests::operator ()()
         { TEST_EQUAL(SingleResult.TestName, Mezzanine::Testing::TestResult::Warning, SingleResult.Results) }
     TEST_EQUAL("GetWorstShouldReturnWarning", Mezzanine::Testing::TestResult::Warning, Warnifier.GetWorstResults())
 
+    // Successes only counted
+    class FailuresOnlyTestTests Counter;
+    Counter();
+    TEST_EQUAL("FailuresOnlyCountsSuccesses", Mezzanine::Whole{3}, Counter.GetUnstoredSuccessCount())
+    TEST_EQUAL("FailuresOnlyStoresFailures", 1, std::distance(Counter.cbegin(), Counter.cend()))
+    TEST_EQUAL("FailuresOnlyWorstIsFailure", Mezzanine::Testing::TestResult::Failed, Counter.GetWorstResults())
+
+    class FailuresOnlyTestTests OverriddenCounter;
+    OverriddenCounter.OverrideSuccessDetails(true);
+    TEST_THROW("FailuresOnlyOverridden", std::runtime_error, [&OverriddenCounter]{ OverriddenCounter(); })
+
+    std::stringstream Summary;
+    Mezzanine::Testing::RenderTestResultSummary(UnitTestGroup::TestDataStorageType(Counter.cbegin(), Counter.cend()),
+                                                Summary,
+                                                Counter.GetUnstoredSuccessCount());
+    TEST_STRING_CONTAINS("FailuresOnlySummaryTotal", Mezzanine::String("From 4 tests"), Summary.str())
+    TEST_STRING_CONTAINS("FailuresOnlySummarySuccesses", Mezzanine::String("Success 3"), Summary.str())
+
     int TestCount = 0;
     int ConstTestCount = 0;
     for(UnitTestGroup::iterator iter = Warnifier.begin(); iter != Warnifier.end(); iter++)
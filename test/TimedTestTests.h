@@ -47,6 +47,7 @@
 #include "TimingTools.h"
 #include "RuntimeStatics.h"
 
+#include <atomic>
 #include <stdexcept>
 #include <thread>
 #include <random>
@@ -343,6 +344,170 @@ BENCHMARK_TEST_GROUP(TimedTestTests, TimedTest)
     TEST_EQUAL("SansZeroEntry1", 1000000, BenchmarkWithoutZeroes.SortedTimings[0].count())
     TEST_EQUAL("SansZeroEntry2", 2000000, BenchmarkWithoutZeroes.SortedTimings[1].count())
     TEST_EQUAL("SansZeroEntry3", 3000000, BenchmarkWithoutZeroes.SortedTimings[2].count())
+    TEST_EQUAL("SansZeroFastest", 1000000, BenchmarkWithoutZeroes.Fastest.count())
+    TEST_EQUAL("SansZeroIterations", MicroBenchmarkResults::CountType{3}, BenchmarkWithoutZeroes.Iterations)
+    TEST_EQUAL("SansZeroTotalUnchanged", BenchmarkWithZeroes.Total.count(), BenchmarkWithoutZeroes.Total.count())
+
+    // Keeping fewer timings must not change any of the numbers, the percentiles are selected instead of sorted.
+    using Mezzanine::Testing::TimingRetention;
+    MicroBenchmarkResults::TimingLists Scrambled;
+    for(MicroBenchmarkResults::TimeType::rep Counter{0}; Counter < 1001; Counter++)
+        { Scrambled.emplace_back(Counter * 7919 % 1009 * (Counter % 3)); }
+    const MicroBenchmarkResults KeptSorted(Scrambled, MicroBenchmarkResults::TimeType{0});
+    const MicroBenchmarkResults KeptUnsorted(Scrambled, MicroBenchmarkResults::TimeType{0}, TimingRetention::Unsorted);
+    const MicroBenchmarkResults KeptNone(Scrambled, MicroBenchmarkResults::TimeType{0}, TimingRetention::None);
+    for(const MicroBenchmarkResults* Kept : { &KeptUnsorted, &KeptNone })
+    {
+        const Mezzanine::String Which{ Kept == &KeptNone ? "None" : "Unsorted" };
+        TEST("RetentionSameNumbers-" + Which,
+             KeptSorted.Iterations == Kept->Iterations && KeptSorted.Total == Kept->Total &&
+             KeptSorted.Average == Kept->Average && KeptSorted.Fastest == Kept->Fastest &&
+             KeptSorted.FasterThan99Percent == Kept->FasterThan99Percent &&
+             KeptSorted.FasterThan90Percent == Kept->FasterThan90Percent &&
+             KeptSorted.Median == Kept->Median &&
+             KeptSorted.FasterThan10Percent == Kept->FasterThan10Percent &&
+             KeptSorted.FasterThan1Percent == Kept->FasterThan1Percent &&
+             KeptSorted.Slowest == Kept->Slowest &&
+             KeptSorted.RelativeStandardError == Kept->RelativeStandardError)
+    }
+    TEST("RetentionUnsortedKeepsOrder", Scrambled == KeptUnsorted.UnsortOriginalTimings &&
+                                        KeptUnsorted.SortedTimings.empty())
+    TEST("RetentionNoneKeepsNothing", KeptNone.UnsortOriginalTimings.empty() && KeptNone.SortedTimings.empty())
+    TEST("RetentionSortedByDefault", KeptSorted.SortedTimings.size() == Scrambled.size() &&
+                                     std::is_sorted(KeptSorted.SortedTimings.cbegin(), KeptSorted.SortedTimings.cend()))
+    bool EveryPercentMatches{true};
+    for(const Mezzanine::PreciseReal Percent : { 0.37, 0.01, 0.99, 0.5, 0.37, 0.0, 1.0 })
+    {
+        EveryPercentMatches = EveryPercentMatches &&
+                              KeptSorted.GetIndexValueFromPercent(Percent) ==
+                              KeptUnsorted.GetIndexValueFromPercent(Percent);
+    }
+    TEST("RetentionUnsortedAnyPercent", EveryPercentMatches)
+    TEST("RetentionUnsortedSelectingKeepsOrder", Scrambled == KeptUnsorted.UnsortOriginalTimings)
+    TEST_THROW("RetentionNoneNoPercent", std::logic_error, [&KeptNone]{ KeptNone.GetIndexValueFromPercent(0.37); })
+    TEST_THROW("RetentionNoneNoZeroFreeCopy", std::logic_error, [&KeptNone]{ KeptNone.CopyWithoutZeroes(); })
+
+    const MicroBenchmarkResults SortedSansZero{ KeptSorted.CopyWithoutZeroes() };
+    const MicroBenchmarkResults UnsortedSansZero{ KeptUnsorted.CopyWithoutZeroes() };
+    TEST("RetentionSansZeroSameNumbers",
+         SortedSansZero.Iterations == UnsortedSansZero.Iterations &&
+         SortedSansZero.Fastest == UnsortedSansZero.Fastest && SortedSansZero.Median == UnsortedSansZero.Median &&
+         SortedSansZero.Slowest == UnsortedSansZero.Slowest && 0 < SortedSansZero.Fastest.count())
+    TEST("RetentionSansZeroStillSorted",
+         std::is_sorted(SortedSansZero.SortedTimings.cbegin(), SortedSansZero.SortedTimings.cend()))
+
+    // Timer calibration, the cost of reading the clock is measured once and removed from every benchmarked timing.
+    using Mezzanine::Testing::TimerCalibration;
+    using std::chrono::nanoseconds;
+
+    const TimerCalibration& Calibration = Mezzanine::Testing::GetTimerCalibration();
+    TEST("TimerCalibrationIsKept", &Calibration == &Mezzanine::Testing::GetTimerCalibration())
+    TEST("TimerCalibrationResolution", 0 < Calibration.Resolution.count())
+    TEST("TimerCalibrationUncertainty", 0 <= Calibration.Uncertainty.count())
+
+    const TimerCalibration KnownOverhead{ nanoseconds{50}, nanoseconds{5}, nanoseconds{1} };
+    TEST_EQUAL("TimerCalibrationRemovesOverhead", 25, KnownOverhead.RemoveOverhead(nanoseconds{75}).count())
+    TEST_EQUAL("TimerCalibrationNeverNegative", 0, KnownOverhead.RemoveOverhead(nanoseconds{20}).count())
+
+    const MicroBenchmarkResults Calibrated({ nanoseconds{100}, nanoseconds{40}, nanoseconds{250} },
+                                           nanoseconds{500},
+                                           KnownOverhead);
+    TEST_EQUAL("TimerCalibrationSubtractedFastest", 0, Calibrated.Fastest.count())
+    TEST_EQUAL("TimerCalibrationSubtractedSlowest", 200, Calibrated.Slowest.count())
+    TEST_EQUAL("TimerCalibrationSubtractedTotal", 250, Calibrated.Total.count())
+    TEST_EQUAL("TimerCalibrationWallTotalKept", 500, Calibrated.WallTotal.count())
+    TEST_EQUAL("TimerCalibrationKept", 50, Calibrated.Calibration.Overhead.count())
+    TEST_EQUAL("TimerCalibrationKeptWithoutZeroes", 50, Calibrated.CopyWithoutZeroes().Calibration.Overhead.count())
+    TEST_EQUAL("TimerCalibrationNotInRawResults", 0, BenchmarkWithZeroes.Calibration.Overhead.count())
+    TEST_EQUAL("TimerCalibrationInBenchmarks",
+               Calibration.Overhead.count(),
+               DurationBench.Calibration.Overhead.count())
+
+    // Batches, each timing covers many calls so calls cheaper than reading the clock can still be measured.
+    const MicroBenchmarkResults Batched({ nanoseconds{1050}, nanoseconds{2050}, nanoseconds{3056} },
+                                        nanoseconds{7000},
+                                        KnownOverhead,
+                                        10);
+    TEST_EQUAL("BatchedBatchSize", MicroBenchmarkResults::CountType{10}, Batched.BatchSize)
+    TEST_EQUAL("BatchedIterations", MicroBenchmarkResults::CountType{30}, Batched.Iterations)
+    TEST_EQUAL("BatchedTimingsPerBatch", MicroBenchmarkResults::CountType{3}, Batched.SortedTimings.size())
+    TEST_EQUAL("BatchedFastestPerCall", 100, Batched.Fastest.count())
+    TEST_EQUAL("BatchedSlowestPerCallRounded", 301, Batched.Slowest.count())
+    TEST_EQUAL("BatchedTotalIsWholeBatches", 6006, Batched.Total.count())
+    TEST_EQUAL("BatchedAveragePerCall", 200, Batched.Average.count())
+    TEST_EQUAL("BatchedKeptWithoutZeroes", Batched.Iterations, Batched.CopyWithoutZeroes().Iterations)
+    TEST_EQUAL("UnbatchedBatchSize", MicroBenchmarkResults::CountType{1}, DurationBench.BatchSize)
+
+    std::atomic<Mezzanine::UInt64> BatchedCalls{0};
+    auto CheapCall = [&BatchedCalls]{ BatchedCalls++; };
+    TEST("FindBatchSizeReachesTarget",
+         1 < Mezzanine::Testing::FindBatchSize(CheapCall, std::chrono::microseconds{50}))
+    BatchedCalls = 0;
+    const MicroBenchmarkResults CheapBench =
+        Mezzanine::Testing::BatchedMicroBenchmark(100, std::move(CheapCall), std::chrono::microseconds{50});
+    TEST("BatchedMicroBenchmarkBatches", 1 < CheapBench.BatchSize)
+    TEST_EQUAL("BatchedMicroBenchmarkSamples", MicroBenchmarkResults::CountType{100}, CheapBench.SortedTimings.size())
+    TEST_EQUAL("BatchedMicroBenchmarkIterations", 100 * CheapBench.BatchSize, CheapBench.Iterations)
+    TEST("BatchedMicroBenchmarkCalledEveryIteration", CheapBench.Iterations <= BatchedCalls.load())
+    TEST("BatchedMicroBenchmarkPerCallUnderTarget", std::chrono::microseconds{50} > CheapBench.Median)
+
+    // Warmup and choosing how many timings to take.
+    using Mezzanine::Testing::AutoIterationCount;
+    using Mezzanine::Testing::MinimumAutoIterations;
+    using Mezzanine::Testing::TimingsAreStable;
+    using Mezzanine::Testing::WarmupWindowSize;
+
+    const MicroBenchmarkResults Spread({ nanoseconds{100}, nanoseconds{200}, nanoseconds{300} }, nanoseconds{600});
+    TEST_WITHIN_RANGE("RelativeStandardError", 0.2886, 0.2887, Spread.RelativeStandardError)
+    TEST_EQUAL("RelativeStandardErrorOfOne", 0.0, SingleBench.RelativeStandardError)
+    TEST_EQUAL("ColdTimingOnlyWhenAuto", 0, Spread.ColdTiming.count())
+
+    const MicroBenchmarkResults::TimingLists Settled(WarmupWindowSize, nanoseconds{100});
+    const MicroBenchmarkResults::TimingLists NearlySettled(WarmupWindowSize, nanoseconds{103});
+    const MicroBenchmarkResults::TimingLists Unsettled(WarmupWindowSize, nanoseconds{200});
+    TEST("WarmupStable", TimingsAreStable(Settled, NearlySettled))
+    TEST("WarmupUnstable", !TimingsAreStable(Settled, Unsettled))
+    TEST("WarmupNeedsTwoWindows", !TimingsAreStable({}, Settled))
+
+    MicroBenchmarkResults::TimingLists Alternating;
+    for(Mezzanine::SizeType Counter{0}; Counter < WarmupWindowSize; Counter++)
+        { Alternating.push_back(nanoseconds{0 == Counter % 2 ? 90 : 110}); }
+    TEST_EQUAL("AutoIterationsForTarget",
+               MicroBenchmarkResults::CountType{107},
+               AutoIterationCount(Alternating, 0.01, std::chrono::seconds{1}))
+    TEST_EQUAL("AutoIterationsWithinBudget",
+               MicroBenchmarkResults::CountType{50},
+               AutoIterationCount(Alternating, 0.01, nanoseconds{5000}))
+    TEST_EQUAL("AutoIterationsAtLeastMinimum",
+               MinimumAutoIterations,
+               AutoIterationCount(Settled, 0.01, std::chrono::seconds{1}))
+
+    // The first call here is slow like a lazy initialization, it should be kept out of everything but ColdTiming.
+    Mezzanine::Boole Initialized{false};
+    std::vector<Mezzanine::UInt64> WarmData(64, 1);
+    auto LazyFunctor = [&Initialized, &WarmData]
+    {
+        if(!Initialized)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            Initialized = true;
+        }
+        std::rotate(WarmData.begin(), WarmData.begin() + 1, WarmData.end());
+    };
+    const MicroBenchmarkResults AutoBench =
+        Mezzanine::Testing::AutoMicroBenchmark(std::move(LazyFunctor), 0.05, std::chrono::seconds{2});
+    TEST("AutoColdTiming", std::chrono::milliseconds{20} <= AutoBench.ColdTiming)
+    TEST("AutoColdTimingKeptOut", AutoBench.Slowest < std::chrono::milliseconds{20})
+    TEST("AutoWarmedUp", 2 * WarmupWindowSize <= AutoBench.WarmupIterations)
+    TEST("AutoAtLeastMinimum", MinimumAutoIterations <= AutoBench.Iterations)
+    TEST_WITHIN_RANGE_PERF("AutoRelativeStandardError", 0.0, 0.1, AutoBench.RelativeStandardError)
+
+    // Timing nothing should now take about nothing, give or take the noise in reading the clock.
+    const MicroBenchmarkResults EmptyBench = MicroBenchmark(10000, []{});
+    TEST_WITHIN_RANGE_PERF("TimerCalibrationEmptyMedian",
+                           nanoseconds::rep{0},
+                           (Calibration.Uncertainty + Calibration.Resolution).count(),
+                           EmptyBench.Median.count())
 
 
     // This is purely for show. In your tests you should never use a hardcoded number because any number of factors